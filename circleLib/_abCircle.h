@@ -12,6 +12,7 @@
 typedef struct AbCircle_s {
   void (*getBounds)(const struct AbCircle_s *circle, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbCircle_s *circle, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
   const u_char *chords;
   const u_char radius;
 } AbCircle;
@@ -24,6 +25,89 @@ void abCircleGetBounds(const AbCircle *circle, const Vec2 *circlePos, Region *bo
  */
 int abCircleCheck(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *pixel);
 
+/** Required by AbShape.  Keeps the last row's half width in geom, so 
+ *  rows visited in order cost a step or two instead of a search.
+ */
+int abCircleSpan(const AbCircle *circle, const Vec2 *circlePos, ShapeGeom *geom, int row, Span spans[]);
+
+/** AbShape circle whose row widths are stored as 2 bit differences
+ *
+ *  deltas packs, for each distance from the center, how much narrower
+ *  that row is than the previous one (see makeCircles.c's
+ *  packChordDeltas): about a third of the flash of a chord vector.  The
+ *  widths are decoded incrementally: span keeps a cursor in the 
+ *  renderer's ShapeGeom, so rendering rows in order decodes one 
+ *  difference per row, and check decodes from the center.  Rows match
+ *  AbCircle's.
+ *  makeCircles generates deltaCircle2 .. deltaCircle150.
+ */
+typedef struct AbDeltaCircle_s {
+  void (*getBounds)(const struct AbDeltaCircle_s *circle, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbDeltaCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbDeltaCircle_s *circle, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+  const u_char *deltas;
+  const u_char radius;
+} AbDeltaCircle;
+
+/** Required by AbShape
+ */
+void abDeltaCircleGetBounds(const AbDeltaCircle *circle, const Vec2 *circlePos, Region *bounds);
+
+/** Required by AbShape
+ */
+int abDeltaCircleCheck(const AbDeltaCircle *circle, const Vec2 *circlePos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+int abDeltaCircleSpan(const AbDeltaCircle *circle, const Vec2 *circlePos, ShapeGeom *geom, int row, Span spans[]);
+
+/** 1/2 width of circle's row at distance dist (at most its radius)
+ *  from its center, decoded from the center
+ */
+u_char abDeltaCircleRowHalf(const AbDeltaCircle *circle, u_char dist);
+
+/** AbShape circle of any radius (1 to 255) without a chord vector
+ *
+ *  Chords are scaled from one table of the first octant of a large
+ *  circle (quarterCircle in chordVec.h, generated by makeCircles), so
+ *  any number of radii cost no more flash than one.  Chords match
+ *  computeChordVec's to within a pixel (see host/scaledcheck.c).
+ *  Initialize with SCALED_CIRCLE:
+ *
+ *    AbScaledCircle ball = SCALED_CIRCLE(37);
+ */
+typedef struct AbScaledCircle_s {
+  void (*getBounds)(const struct AbScaledCircle_s *circle, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbScaledCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbScaledCircle_s *circle, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+  const u_char radius;
+  const u_int step;		/* quarterCircle entries per pixel, 7 fraction bits */
+} AbScaledCircle;
+
+/** quarterCircle entries per radius */
+#define QUARTER_CIRCLE_STEPS 256
+
+#define SCALED_CIRCLE(radius) {abScaledCircleGetBounds, abScaledCircleCheck, \
+      abScaledCircleSpan, (radius),					\
+      ((QUARTER_CIRCLE_STEPS * 128L) + (radius) / 2) / (radius)}
+
+/** Required by AbShape
+ */
+void abScaledCircleGetBounds(const AbScaledCircle *circle, const Vec2 *circlePos, Region *bounds);
+
+/** Required by AbShape
+ */
+int abScaledCircleCheck(const AbScaledCircle *circle, const Vec2 *circlePos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+int abScaledCircleSpan(const AbScaledCircle *circle, const Vec2 *circlePos, ShapeGeom *geom, int row, Span spans[]);
+
+/** 1/2 chord length of circle at distance dist (at most its radius)
+ *  from its center
+ */
+u_char abScaledCircleChord(const AbScaledCircle *circle, u_char dist);
+
 #endif
 
 
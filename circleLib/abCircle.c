@@ -5,13 +5,61 @@
 int abCircleCheck(const AbCircle *circle, const Vec2 *centerPos, const Vec2 *pixel)
 {
   u_char radius = circle->radius;
-  int axis;
-  Vec2 relPos;
-  vec2Sub(&relPos, pixel, centerPos); /* vector from center to pixel */
-  vec2Abs(&relPos);		      /* project to first quadrant */
-  return (relPos.axes[0] <= radius && circle->chords[relPos.axes[0]] >= relPos.axes[1]);
+  int col = pixel->axes[0] - centerPos->axes[0]; /* vector from center to pixel */
+  int row = pixel->axes[1] - centerPos->axes[1];
+  col = (col >= 0) ? col : -col;      /* project to first quadrant */
+  row = (row >= 0) ? row : -row;
+  return (col <= radius && circle->chords[col] >= row);
 }
-  
+
+// widest col whose chord reaches dist (at most radius) from the center
+static int
+abCircleRowHalf(const AbCircle *circle, int dist)
+{
+  const u_char *chords = circle->chords;
+  int lo = 0, hi = circle->radius;
+  /* chords are indexed by col and never increase */
+  while (lo < hi) {
+    int mid = (lo + hi + 1) >> 1;
+    if (chords[mid] >= dist)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+// the single span of row within circle centered at centerPos.
+// geom keeps the last row's distance from the center and half width
+// (derived[0] and [1]): consecutive rows step from it rather than
+// searching the chords again
+int
+abCircleSpan(const AbCircle *circle, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  const u_char *chords = circle->chords;
+  int dist = row - centerPos->axes[1], half;
+  dist = (dist >= 0) ? dist : -dist; /* project to first quadrant */
+  if (chords[0] < dist)
+    return 0;
+  if (!geom->derivedValid) {
+    half = abCircleRowHalf(circle, dist);
+    geom->derivedValid = 1;
+  } else {
+    half = geom->derived[1];
+    if (dist > geom->derived[0])	/* farther out: narrower */
+      while (chords[half] < dist)
+	half--;
+    else			/* nearer: wider */
+      while (half < circle->radius && chords[half + 1] >= dist)
+	half++;
+  }
+  geom->derived[0] = dist;
+  geom->derived[1] = half;
+  spans[0].colStart = centerPos->axes[0] - half;
+  spans[0].colEnd = centerPos->axes[0] + half;
+  return 1;
+}
+
 void
 abCircleGetBounds(const AbCircle *circle, const Vec2 *centerPos, Region *bounds)
 {
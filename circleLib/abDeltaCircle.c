@@ -0,0 +1,114 @@
+#include "shape.h"
+#include "_abCircle.h"
+
+/** Position of a decoder within a circle's deltas */
+typedef struct {
+  u_int bit;			/* code for the step from dist to dist+1 */
+  u_char dist, rowHalf;
+} DeltaCursor;
+
+// 2 bit code at bit (always even)
+static u_char
+deltaCode(const u_char *deltas, u_int bit)
+{
+  return (deltas[bit >> 3] >> (6 - (bit & 7))) & 3;
+}
+
+// 8 bit escaped value at bit
+static u_char
+deltaByte(const u_char *deltas, u_int bit)
+{
+  const u_char *p = &deltas[bit >> 3];
+  u_char shift = bit & 7;
+  if (!shift)
+    return p[0];
+  return (p[0] << shift) | (p[1] >> (8 - shift));
+}
+
+// walk c to dist: one code per row moved, in either direction
+static u_char
+deltaWalk(const u_char *deltas, DeltaCursor *c, u_char dist)
+{
+  u_int bit = c->bit;
+  u_char rowHalf = c->rowHalf, at = c->dist;
+  while (at < dist) {		/* outward: narrower */
+    u_char code = deltaCode(deltas, bit);
+    bit += 2;
+    if (code == 3) {
+      rowHalf -= deltaByte(deltas, bit);
+      bit += 10;		/* value and closing escape */
+    } else
+      rowHalf -= code;
+    at++;
+  }
+  while (at > dist) {		/* inward: wider */
+    u_char code = deltaCode(deltas, bit - 2);
+    bit -= 2;
+    if (code == 3) {
+      rowHalf += deltaByte(deltas, bit - 8);
+      bit -= 10;		/* value and opening escape */
+    } else
+      rowHalf += code;
+    at--;
+  }
+  c->bit = bit;
+  c->dist = at;
+  c->rowHalf = rowHalf;
+  return rowHalf;
+}
+
+// decode from the center
+u_char
+abDeltaCircleRowHalf(const AbDeltaCircle *circle, u_char dist)
+{
+  DeltaCursor c = {0, 0, circle->radius};
+  return deltaWalk(circle->deltas, &c, dist);
+}
+
+// true if pixel is in circle centered at centerPos
+int
+abDeltaCircleCheck(const AbDeltaCircle *circle, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0]; /* vector from center to pixel */
+  int row = pixel->axes[1] - centerPos->axes[1];
+  col = (col >= 0) ? col : -col;      /* project to first quadrant */
+  row = (row >= 0) ? row : -row;
+  return (row <= circle->radius && col <= abDeltaCircleRowHalf(circle, row));
+}
+
+// the single span of row within circle centered at centerPos.
+// geom keeps the decoder's cursor: its bit (derived[0]) and its row's
+// distance and half width (derived[1]), so consecutive rows decode one
+// difference each
+int
+abDeltaCircleSpan(const AbDeltaCircle *circle, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  int dist = row - centerPos->axes[1], half;
+  DeltaCursor c = {0, 0, circle->radius};
+  dist = (dist >= 0) ? dist : -dist; /* project to first quadrant */
+  if (dist > circle->radius)
+    return 0;
+  if (geom->derivedValid) {
+    c.bit = geom->derived[0];
+    c.dist = (u_int)geom->derived[1] >> 8;
+    c.rowHalf = geom->derived[1];
+  }
+  half = deltaWalk(circle->deltas, &c, dist);
+  geom->derived[0] = c.bit;
+  geom->derived[1] = (c.dist << 8) | c.rowHalf;
+  geom->derivedValid = 1;
+  spans[0].colStart = centerPos->axes[0] - half;
+  spans[0].colEnd = centerPos->axes[0] + half;
+  return 1;
+}
+
+void
+abDeltaCircleGetBounds(const AbDeltaCircle *circle, const Vec2 *centerPos, Region *bounds)
+{
+  u_char axis, radius = circle->radius;
+  for (axis = 0; axis < 2; axis ++) {
+    bounds->topLeft.axes[axis] = centerPos->axes[axis] - radius;
+    bounds->botRight.axes[axis] = centerPos->axes[axis] + radius;
+  }
+  regionClipScreen(bounds);
+}
@@ -0,0 +1,69 @@
+#include "shape.h"
+#include "_abCircle.h"
+#include "chordVec.h"
+
+// 1/2 chord at dist within the first octant, interpolated from quarterCircle
+static u_char
+firstOctantChord(const AbScaledCircle *circle, u_char dist)
+{
+  u_int t = dist * circle->step; /* table position, 7 fraction bits */
+  const u_int *entry = &quarterCircle[t >> 7];
+  u_int q = entry[0] - (((entry[0] - entry[1]) * (t & 127)) >> 7);
+  return ((unsigned long)circle->radius * q + 32768) >> 16;
+}
+
+// first octant: scale the table.  second: find the first row whose
+// first octant chord reaches no further than dist (as computeChordVec does)
+u_char
+abScaledCircleChord(const AbScaledCircle *circle, u_char dist)
+{
+  u_int radius = circle->radius;
+  u_char lo = 0, hi;
+  if ((u_int)dist * dist <= (radius * radius) >> 1)
+    return firstOctantChord(circle, dist);
+  hi = ((radius * 181) >> 8) + 1; /* just past radius/sqrt(2) */
+  while (lo < hi) {
+    u_char mid = (lo + hi) >> 1;
+    if (firstOctantChord(circle, mid) <= dist)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// true if pixel is in circle centered at centerPos
+int
+abScaledCircleCheck(const AbScaledCircle *circle, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0]; /* vector from center to pixel */
+  int row = pixel->axes[1] - centerPos->axes[1];
+  col = (col >= 0) ? col : -col;      /* project to first quadrant */
+  row = (row >= 0) ? row : -row;
+  return (row <= circle->radius && col <= abScaledCircleChord(circle, row));
+}
+
+// the single span of row within circle centered at centerPos
+int
+abScaledCircleSpan(const AbScaledCircle *circle, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  int dist = row - centerPos->axes[1], half;
+  dist = (dist >= 0) ? dist : -dist; /* project to first quadrant */
+  if (dist > circle->radius)
+    return 0;
+  half = abScaledCircleChord(circle, dist);
+  spans[0].colStart = centerPos->axes[0] - half;
+  spans[0].colEnd = centerPos->axes[0] + half;
+  return 1;
+}
+
+void
+abScaledCircleGetBounds(const AbScaledCircle *circle, const Vec2 *centerPos, Region *bounds)
+{
+  u_char axis, radius = circle->radius;
+  for (axis = 0; axis < 2; axis ++) {
+    bounds->topLeft.axes[axis] = centerPos->axes[axis] - radius;
+    bounds->botRight.axes[axis] = centerPos->axes[axis] + radius;
+  }
+  regionClipScreen(bounds);
+}
@@ -3,7 +3,7 @@
 #include <lcddraw.h>
 #include "abCircle.h"
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, {10,10}};; /**< 10x10 rectangle */
+AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, {10,10}};; /**< 10x10 rectangle */
 
 u_int bgColor = COLOR_BLUE;
 
@@ -33,6 +33,7 @@ main()
   clearScreen(COLOR_BLUE);
   drawString5x7(20,20, "hello", COLOR_GREEN, COLOR_RED);
 
+  layerInit(&layer0);
   layerDraw(&layer0);
 
 }
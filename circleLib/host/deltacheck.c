@@ -0,0 +1,126 @@
+/** \file deltacheck.c
+ *  \brief Host test: AbDeltaCircle rows against AbCircle's.
+ *
+ *  For every radius makeCircles generates (2 to 150), packs the row
+ *  widths as makeCircles does and checks that abDeltaCircleSpan and
+ *  abDeltaCircleCheck agree with abCircleSpan and abCircleCheck when
+ *  rows are visited top to bottom, at random, interleaved with other
+ *  circles, and interleaved with the same circle elsewhere (as two
+ *  layers sharing it are drawn).  Each circle keeps one ShapeGeom per
+ *  shape throughout, so abCircleSpan and abDeltaCircleSpan step from
+ *  the row they last measured, and the spans are checked against
+ *  abCircleCheck.  Reports the flash used by the chord vectors and by
+ *  the packed deltas.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "shape.h"
+#include "_abCircle.h"
+
+#define main makeCircles	/* only the table builders are wanted */
+#include "../makeCircles.c"
+#undef main
+
+#define NUM_INTERLEAVED 6
+
+static unsigned char chordVecs[151][151], packedDeltas[151][4 * 151 + 8];
+
+/** Both circles at one position, each with its ShapeGeom there */
+typedef struct {
+  const AbCircle *circle;
+  const AbDeltaCircle *deltaCircle;
+  Vec2 center;
+  ShapeGeom geom, deltaGeom;
+} CirclePair;
+
+static void
+pairInit(CirclePair *pair, const AbCircle *circle, const AbDeltaCircle *deltaCircle, int centerRow)
+{
+  pair->circle = circle;
+  pair->deltaCircle = deltaCircle;
+  pair->center.axes[0] = circle->radius;
+  pair->center.axes[1] = centerRow;
+  abShapeGeom((const AbShape *)circle, &pair->center, &pair->geom);
+  abShapeGeom((const AbShape *)deltaCircle, &pair->center, &pair->deltaGeom);
+}
+
+// compare one row (relative to the top of the circle, and the pixels 
+// around it) of both circles
+static int
+sameRow(CirclePair *pair, int row)
+{
+  const AbCircle *circle = pair->circle;
+  const AbDeltaCircle *deltaCircle = pair->deltaCircle;
+  const Vec2 center = pair->center;
+  int radius = circle->radius, col, n;
+  Span spans[SHAPE_MAX_SPANS], deltaSpans[SHAPE_MAX_SPANS];
+  row += center.axes[1] - radius;
+  n = abCircleSpan(circle, &center, &pair->geom, row, spans);
+  if (abDeltaCircleSpan(deltaCircle, &center, &pair->deltaGeom, row, deltaSpans) != n
+      || (n && (spans[0].colStart != deltaSpans[0].colStart
+		|| spans[0].colEnd != deltaSpans[0].colEnd))) {
+    printf("radius %d row %d: span differs\n", radius, row);
+    return 0;
+  }
+  for (col = -1; col <= 2 * radius + 1; col += 1 + (col & 3)) {
+    Vec2 pixel = {col, row};
+    int inSpan = n && col >= spans[0].colStart && col <= spans[0].colEnd;
+    if (!abCircleCheck(circle, &center, &pixel) != !abDeltaCircleCheck(deltaCircle, &center, &pixel)
+	|| !abCircleCheck(circle, &center, &pixel) != !inSpan) {
+      printf("radius %d row %d col %d: check differs\n", radius, row, col);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int
+main()
+{
+  static AbCircle circles[151];
+  static AbDeltaCircle deltaCircles[151];
+  static CirclePair pairs[151];
+  long chordBytes = 0, deltaBytes = 0;
+  int radius, row, i;
+  for (radius = 2; radius <= 150; radius++) {
+    unsigned char rowHalf[151];
+    AbCircle circle = {abCircleGetBounds, abCircleCheck, abCircleSpan, chordVecs[radius], radius};
+    AbDeltaCircle deltaCircle = {abDeltaCircleGetBounds, abDeltaCircleCheck, abDeltaCircleSpan,
+				 packedDeltas[radius], radius};
+    computeChordVec(chordVecs[radius], radius);
+    computeRowHalves(rowHalf, chordVecs[radius], radius);
+    chordBytes += radius + 1;
+    deltaBytes += packChordDeltas(packedDeltas[radius], rowHalf, radius);
+    memcpy(&circles[radius], &circle, sizeof circle);
+    memcpy(&deltaCircles[radius], &deltaCircle, sizeof deltaCircle);
+    pairInit(&pairs[radius], &circles[radius], &deltaCircles[radius], radius);
+  }
+  for (radius = 2; radius <= 150; radius++) /* in rendering order */
+    for (row = -1; row <= 2 * radius + 1; row++)
+      if (!sameRow(&pairs[radius], row))
+	return 1;
+  srand(1);
+  for (i = 0; i < 200000; i++) { /* at random */
+    radius = 2 + rand() % 149;
+    row = rand() % (2 * radius + 3) - 1;
+    if (!sameRow(&pairs[radius], row))
+      return 1;
+  }
+  for (radius = 2; radius + NUM_INTERLEAVED <= 151; radius += NUM_INTERLEAVED)
+    for (row = -1; row <= 2 * (radius + NUM_INTERLEAVED) + 1; row++) /* side by side */
+      for (i = 0; i < NUM_INTERLEAVED; i++)
+	if (!sameRow(&pairs[radius + i], row))
+	  return 1;
+  for (radius = 2; radius <= 150; radius++) { /* two layers, one circle */
+    CirclePair upper, lower;
+    pairInit(&upper, &circles[radius], &deltaCircles[radius], radius);
+    pairInit(&lower, &circles[radius], &deltaCircles[radius], radius + radius / 2 + 1);
+    for (row = -1; row <= 2 * radius + 1; row++)
+      if (!sameRow(&upper, row) || !sameRow(&lower, row - radius / 2 - 1))
+	return 1;
+  }
+  printf("delta circles match: chord vectors %ld bytes, deltas %ld bytes (%ld%%)\n",
+	 chordBytes, deltaBytes, 100 * deltaBytes / chordBytes);
+  return 0;
+}
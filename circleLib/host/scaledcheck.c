@@ -0,0 +1,53 @@
+/** \file scaledcheck.c
+ *  \brief Host test: AbScaledCircle chords against computeChordVec's.
+ *
+ *  For every radius makeCircles generates (2 to 150), compares the
+ *  chord AbScaledCircle derives from quarterCircle at each distance
+ *  with the Bresenham chord vector, and checks that abScaledCircleSpan
+ *  and abScaledCircleCheck agree.  Fails if any chord is off by more
+ *  than a pixel.
+ */
+#include <stdio.h>
+#include "shape.h"
+#include "_abCircle.h"
+
+#define main makeCircles	/* only computeChordVec is wanted */
+#include "../makeCircles.c"
+#undef main
+
+int
+main()
+{
+  int radius, dist, col, exact = 0, total = 0, worst = 0;
+  for (radius = 2; radius <= 150; radius++) {
+    unsigned char chordVec[151];
+    AbScaledCircle circle = SCALED_CIRCLE(radius);
+    Vec2 center = {radius, radius};
+    ShapeGeom geom;
+    computeChordVec(chordVec, radius);
+    abShapeGeom((const AbShape *)&circle, &center, &geom);
+    for (dist = 0; dist <= radius; dist++) {
+      int chord = abScaledCircleChord(&circle, dist), err = chord - chordVec[dist];
+      Span spans[SHAPE_MAX_SPANS];
+      err = err < 0 ? -err : err;
+      worst = err > worst ? err : worst;
+      exact += !err;
+      total++;
+      if (abScaledCircleSpan(&circle, &center, &geom, radius + dist, spans) != 1
+	  || spans[0].colEnd - radius != chord) {
+	printf("radius %d dist %d: span differs from chord\n", radius, dist);
+	return 1;
+      }
+      for (col = 0; col <= radius + 1; col++) {
+	Vec2 pixel = {radius + col, radius - dist};
+	if (abScaledCircleCheck(&circle, &center, &pixel) != (col <= chord)) {
+	  printf("radius %d dist %d col %d: check differs from span\n", radius, dist, col);
+	  return 1;
+	}
+      }
+    }
+  }
+  printf("%d of %d chords match computeChordVec, worst error %d pixel(s)\n",
+	 exact, total, worst);
+  return worst > 1;
+}
@@ -35,9 +35,79 @@ void computeChordVec(unsigned char chordVec[], unsigned char radius)
   }
 }
 
+///////////////////////////////////////////
+// build table quarter[i] of the first octant of a circle of radius 65536
+// at distances i * 65536/QUARTER_STEPS from its center, for AbScaledCircle,
+// which scales it to any radius.  Beyond 1/sqrt(2) of the radius (entry
+// 181) AbScaledCircle searches the first octant instead.
+///////////////////////////////////////////
+#define QUARTER_STEPS 256	/* entries per radius */
+#define QUARTER_SIZE (QUARTER_STEPS * 181 / 256 + 3) /* to 1/sqrt(2), +2 to interpolate */
+
+void computeQuarterCircle(unsigned int quarter[])
+{
+  unsigned long long one = 65536, rSquared = one * one;
+  int i;
+  for (i = 0; i < QUARTER_SIZE; i++) {
+    unsigned long long d = one * i / QUARTER_STEPS, x = 0, bit;
+    unsigned long long xSquared = 4 * (rSquared - d * d); /* (2x)**2: round below */
+    for (bit = one << 1; bit; bit >>= 1) /* integer square root */
+      if ((x + bit) * (x + bit) <= xSquared)
+	x += bit;
+    x = (x + 1) >> 1;		/* 2x rounded to nearest x */
+    quarter[i] = x > 65535 ? 65535 : x;
+  }
+}
+
 #include "stdio.h"
 #include "assert.h"
 
+///////////////////////////////////////////
+// build rowHalf[d]: 1/2 width of the row at distance d from center, as
+// abCircleSpan finds it (the widest col whose chord reaches the row)
+///////////////////////////////////////////
+void computeRowHalves(unsigned char rowHalf[], const unsigned char chordVec[], int radius)
+{
+  int dist, col = radius;
+  for (dist = 0; dist <= radius; dist++) {
+    while (chordVec[col] < dist)	/* chords never increase with col */
+      col--;
+    rowHalf[dist] = col;
+  }
+}
+
+///////////////////////////////////////////
+// pack the decrease between successive entries of non-increasing
+// v[0..n] as 2 bit codes, first code in the MSBs: 0..2 are the decrease,
+// 3 escapes an 8 bit decrease, which is followed by another 3 so that
+// the codes can also be read backwards.  Returns the number of bytes.
+///////////////////////////////////////////
+int packChordDeltas(unsigned char packed[], const unsigned char v[], int n)
+{
+  int i, bit = 0;
+  for (i = 0; i < 4 * n + 8; i++)
+    packed[i] = 0;
+  for (i = 1; i <= n; i++) {
+    int delta = v[i - 1] - v[i], k;
+    int fields[3], numFields = 0, widths[3];
+    assert(delta >= 0 && delta <= 255);
+    if (delta < 3) {
+      fields[numFields] = delta; widths[numFields++] = 2;
+    } else {
+      fields[numFields] = 3; widths[numFields++] = 2;
+      fields[numFields] = delta; widths[numFields++] = 8;
+      fields[numFields] = 3; widths[numFields++] = 2;
+    }
+    for (k = 0; k < numFields; k++) {
+      int b;
+      for (b = widths[k] - 1; b >= 0; b--, bit++)
+	if (fields[k] & (1 << b))
+	  packed[bit >> 3] |= 0x80 >> (bit & 7);
+    }
+  }
+  return (bit + 7) >> 3;
+}
+
 
 // Generate circles as source files
 // (c) Eric Freudenthal, 2016
@@ -80,13 +150,50 @@ int main()
       fprintf(fp, "#include \"abCircle.h\"\n\n");
       fprintf(fp, "#include \"chordVec.h\"\n\n");
       fprintf(fp, "const AbCircle circle%d = {" , radius);
-      fprintf(fp, "  abCircleGetBounds, abCircleCheck, chordVec%d, %d", radius, radius);
+      fprintf(fp, "  abCircleGetBounds, abCircleCheck, abCircleSpan, chordVec%d, %d", radius, radius);
+      fprintf(fp, "};\n");
+      fclose(fp);
+    }
+    {				/* deltaCircleN.c */
+      unsigned char rowHalf[151], packed[4 * 151 + 8];
+      int i, size;
+      computeRowHalves(rowHalf, (unsigned char *)chordVec, radius);
+      size = packChordDeltas(packed, rowHalf, radius);
+      sprintf(filename, "circles/deltaCircle%d.c", radius);
+      FILE *fp = fopen(filename, "w");
+      assert(fp);
+      fprintf(fp, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
+      fprintf(fp, "#include \"abCircle.h\"\n\n");
+      fprintf(fp, "static const unsigned char chordDeltas[%d] = {", size);
+      for (i = 0; i < size; i++)
+	fprintf(fp, "%s0x%02x,", (i % 12) ? " " : "\n    ", packed[i]);
+      fprintf(fp, "\n};\n\n");
+      fprintf(fp, "const AbDeltaCircle deltaCircle%d = {", radius);
+      fprintf(fp, "  abDeltaCircleGetBounds, abDeltaCircleCheck, abDeltaCircleSpan, chordDeltas, %d", radius);
       fprintf(fp, "};\n");
       fclose(fp);
     }
     				/* includes */
     fprintf(chordIncludeFile, "extern const unsigned char chordVec%d[%d];\n", radius, radius+1);
     fprintf(circleIncludeFile, "extern const AbCircle circle%d;\n" , radius);
+    fprintf(circleIncludeFile, "extern const AbDeltaCircle deltaCircle%d;\n" , radius);
+  }
+
+  {				/* quarterCircle.c */
+    unsigned int quarter[QUARTER_SIZE];
+    int i;
+    FILE *fp = fopen("circles/quarterCircle.c", "w");
+    assert(fp);
+    computeQuarterCircle(quarter);
+    fprintf(fp, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
+    fprintf(fp, "#include \"chordVec.h\"\n\n");
+    fprintf(fp, "const unsigned int quarterCircle[%d] = {\n", QUARTER_SIZE);
+    for (i = 0; i < QUARTER_SIZE; i++)
+      fprintf(fp, "    %u, // dist = %d/%d\n", quarter[i], i, QUARTER_STEPS);
+    fprintf(fp, "};\n\n");
+    fclose(fp);
+    fprintf(chordIncludeFile, "\n/* first octant of a circle of radius 65536 (for AbScaledCircle) */\n");
+    fprintf(chordIncludeFile, "extern const unsigned int quarterCircle[%d];\n", QUARTER_SIZE);
   }
 
   fprintf(circleIncludeFile, "\n#endif // included \n");
@@ -0,0 +1,35 @@
+#ifndef abEllipse_included
+#define abEllipse_included
+
+#include "shape.h"
+
+/** AbShape ellipse (an axis-aligned oval)
+ *
+ *  chords should be a vector of length halfHeight + 1.
+ *  Entry at index i is 1/2 the width of the row at distance i from the
+ *  ellipse's center (so a row's span is a single lookup).
+ *  makeEllipses generates ellipseWxH for half widths W and half heights
+ *  H from 1 to 30 (abEllipse_decls.h), using the midpoint ellipse
+ *  algorithm (computeEllipseChords() in makeEllipses.c).
+ */
+typedef struct AbEllipse_s {
+  void (*getBounds)(const struct AbEllipse_s *ellipse, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbEllipse_s *ellipse, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbEllipse_s *ellipse, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+  const u_char *chords;
+  const u_char halfWidth, halfHeight;
+} AbEllipse;
+
+/** Required by AbShape
+ */
+void abEllipseGetBounds(const AbEllipse *ellipse, const Vec2 *centerPos, Region *bounds);
+
+/** Required by AbShape
+ */
+int abEllipseCheck(const AbEllipse *ellipse, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+int abEllipseSpan(const AbEllipse *ellipse, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+
+#endif // included
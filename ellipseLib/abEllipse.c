@@ -0,0 +1,37 @@
+#include "shape.h"
+#include "_abEllipse.h"
+
+// true if pixel is in ellipse centered at centerPos
+int
+abEllipseCheck(const AbEllipse *ellipse, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0]; /* vector from center to pixel */
+  int row = pixel->axes[1] - centerPos->axes[1];
+  col = (col >= 0) ? col : -col;      /* project to first quadrant */
+  row = (row >= 0) ? row : -row;
+  return (row <= ellipse->halfHeight && col <= ellipse->chords[row]);
+}
+
+// the single span of row within ellipse centered at centerPos
+int
+abEllipseSpan(const AbEllipse *ellipse, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  int dist = row - centerPos->axes[1], half;
+  dist = (dist >= 0) ? dist : -dist; /* project to first quadrant */
+  if (dist > ellipse->halfHeight)
+    return 0;
+  half = ellipse->chords[dist];
+  spans[0].colStart = centerPos->axes[0] - half;
+  spans[0].colEnd = centerPos->axes[0] + half;
+  return 1;
+}
+
+void
+abEllipseGetBounds(const AbEllipse *ellipse, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft.axes[0] = centerPos->axes[0] - ellipse->halfWidth;
+  bounds->topLeft.axes[1] = centerPos->axes[1] - ellipse->halfHeight;
+  bounds->botRight.axes[0] = centerPos->axes[0] + ellipse->halfWidth;
+  bounds->botRight.axes[1] = centerPos->axes[1] + ellipse->halfHeight;
+  regionClipScreen(bounds);
+}
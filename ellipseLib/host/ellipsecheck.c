@@ -0,0 +1,71 @@
+/** \file ellipsecheck.c
+ *  \brief Host test: generated ellipse chords against the true curve.
+ *
+ *  For every size makeEllipses generates, checks that the widest row
+ *  is the half width, that rows never widen away from the center, and
+ *  that each row ends within a pixel of the ellipse (measured across
+ *  the curve, so flat ellipses' long rows aren't penalized).  Also
+ *  checks that abEllipseSpan and abEllipseCheck agree.
+ */
+#include <stdio.h>
+#include <math.h>
+#include "shape.h"
+#include "_abEllipse.h"
+
+#define main makeEllipses	/* only computeEllipseChords is wanted */
+#include "../makeEllipses.c"
+#undef main
+
+int
+main()
+{
+  int halfWidth, halfHeight, dist, col, exact = 0, total = 0;
+  double worst = 0;
+  for (halfHeight = 1; halfHeight <= MAX_HALF_HEIGHT; halfHeight++)
+    for (halfWidth = 1; halfWidth <= MAX_HALF_WIDTH; halfWidth++) {
+      unsigned char chords[MAX_HALF_HEIGHT + 1];
+      AbEllipse ellipse = {abEllipseGetBounds, abEllipseCheck, abEllipseSpan,
+			   chords, halfWidth, halfHeight};
+      Vec2 center = {halfWidth + 1, halfHeight + 1};
+      ShapeGeom geom;
+      computeEllipseChords(chords, halfWidth, halfHeight);
+      abShapeGeom((const AbShape *)&ellipse, &center, &geom);
+      if (chords[0] != halfWidth) {
+	printf("%dx%d: center row is %d wide\n", halfWidth, halfHeight, chords[0]);
+	return 1;
+      }
+      for (dist = 0; dist <= halfHeight; dist++) {
+	double a2 = halfWidth * halfWidth, b2 = halfHeight * halfHeight;
+	double x = chords[dist], y = dist;
+	/* distance from the row's last pixel to the curve, to first order */
+	double err = fabs(x * x / a2 + y * y / b2 - 1) / hypot(2 * x / a2, 2 * y / b2);
+	double curve = halfWidth * sqrt(1 - y * y / b2);
+	Span spans[SHAPE_MAX_SPANS];
+	worst = err > worst ? err : worst;
+	exact += chords[dist] == (int)(curve + 0.5);
+	total++;
+	if (err > 1 || (dist && chords[dist] > chords[dist - 1])) {
+	  printf("%dx%d dist %d: chord %d is %.2f pixels from the curve\n", halfWidth, halfHeight,
+		 dist, chords[dist], err);
+	  return 1;
+	}
+	if (abEllipseSpan(&ellipse, &center, &geom, center.axes[1] + dist, spans) != 1
+	    || spans[0].colEnd - center.axes[0] != chords[dist]
+	    || spans[0].colStart - center.axes[0] != -chords[dist]) {
+	  printf("%dx%d dist %d: span differs from chord\n", halfWidth, halfHeight, dist);
+	  return 1;
+	}
+	for (col = 0; col <= 2 * halfWidth + 2; col++) {
+	  Vec2 pixel = {col, center.axes[1] - dist};
+	  int inside = col - center.axes[0] >= -chords[dist] && col - center.axes[0] <= chords[dist];
+	  if (!abEllipseCheck(&ellipse, &center, &pixel) != !inside) {
+	    printf("%dx%d dist %d col %d: check differs from span\n", halfWidth, halfHeight, dist, col);
+	    return 1;
+	  }
+	}
+      }
+    }
+  printf("%d of %d rows end at the nearest pixel, worst %.2f pixel(s) from the curve\n",
+	 exact, total, worst);
+  return 0;
+}
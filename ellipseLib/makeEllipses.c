@@ -0,0 +1,105 @@
+
+///////////////////////////////////////////
+// build table chords[d] of ellipse 1/2 widths at distances d (0 to
+// halfHeight) from center, along its vertical axis
+// Uses the midpoint ellipse algorithm: sweeps the first quadrant from
+// (0, halfHeight) to (halfWidth, 0), choosing between the two candidate
+// pixels by the sign of the ellipse equation at their midpoint.
+// Used makeCircles.c template created by Eric Freudenthal and David Pruitt 2016
+// Modified from RobG's EduKit by Jose M. Perez Jr. 2017
+///////////////////////////////////////////
+void computeEllipseChords(unsigned char chords[], int halfWidth, int halfHeight)
+{
+  long a2 = (long)halfWidth * halfWidth, b2 = (long)halfHeight * halfHeight;
+  long col = 0, row = halfHeight;	/* first coordinate (0, halfHeight) */
+  long dCol = 0;		/* 2 * b2 * col: change in error per unit col */
+  long dRow = 2 * a2 * row;	/* 2 * a2 * row: change in error per unit row */
+  long err;			/* 4 * ellipse equation at the midpoint */
+  int d;
+
+  for (d = 0; d <= halfHeight; d++)
+    chords[d] = 0;
+
+  /* region 1: slope > -1, col always advances; keep the last col of each row */
+  err = 4 * b2 - 4 * a2 * halfHeight + a2; /* at (1, halfHeight - 1/2) */
+  while (dCol < dRow) {
+    chords[row] = col;
+    col++;
+    dCol += 2 * b2;
+    if (err < 0)		/* midpoint inside: stay on this row */
+      err += 4 * (dCol + b2);
+    else {			/* midpoint outside: move in a row */
+      row--;
+      dRow -= 2 * a2;
+      err += 4 * (dCol - dRow + b2);
+    }
+  }
+
+  /* region 2: slope <= -1, row always advances */
+  err = b2 * (2 * col + 1) * (2 * col + 1) + 4 * a2 * (row - 1) * (row - 1)
+    - 4 * a2 * b2;		/* at (col + 1/2, row - 1) */
+  while (row >= 0) {
+    if (chords[row] < col)
+      chords[row] = col;
+    row--;
+    dRow -= 2 * a2;
+    if (err > 0)		/* midpoint outside: keep col */
+      err += 4 * (a2 - dRow);
+    else {			/* midpoint inside: move out a col */
+      col++;
+      dCol += 2 * b2;
+      err += 4 * (dCol - dRow + a2);
+    }
+  }
+  chords[0] = halfWidth;	/* very flat ellipses leave region 1 short of it */
+}
+
+#include "stdio.h"
+#include "assert.h"
+
+#define MAX_HALF_WIDTH 30
+#define MAX_HALF_HEIGHT 30
+
+// Generate ellipses as source files
+int main()
+{
+  int halfWidth, halfHeight;
+  unsigned char chords[MAX_HALF_HEIGHT + 1];
+  FILE *ellipseIncludeFile = fopen("abEllipse_decls.h", "w");
+  assert(ellipseIncludeFile);
+
+  fprintf(ellipseIncludeFile, "// Automatically generated by makeEllipses.\n");
+  fprintf(ellipseIncludeFile, "#ifndef abEllipse_decls_included\n#define abEllipse_decls_included\n\n");
+
+  for (halfHeight = 1; halfHeight <= MAX_HALF_HEIGHT; halfHeight++) {
+    for (halfWidth = 1; halfWidth <= MAX_HALF_WIDTH; halfWidth++) {
+      char filename[100];
+      int d;
+
+      computeEllipseChords(chords, halfWidth, halfHeight);
+
+      {				/* ellipseWxH.c */
+	sprintf(filename, "ellipses/ellipse%dx%d.c", halfWidth, halfHeight);
+	FILE *fp = fopen(filename, "w");
+	assert(fp);
+	fprintf(fp, "// Automatically generated by makeEllipses.\n");
+	fprintf(fp, "#include \"abEllipse.h\"\n\n");
+	fprintf(fp, "static const unsigned char chords[%d] = {\n", halfHeight + 1);
+	for (d = 0; d <= halfHeight; d++)
+	  fprintf(fp, "    %d, // dist along vertical axis = %d\n", chords[d], d);
+	fprintf(fp, "};\n\n");
+	fprintf(fp, "const AbEllipse ellipse%dx%d = {", halfWidth, halfHeight);
+	fprintf(fp, "  abEllipseGetBounds, abEllipseCheck, abEllipseSpan, chords, %d, %d",
+		halfWidth, halfHeight);
+	fprintf(fp, "};\n");
+	fclose(fp);
+      }
+      				/* includes */
+      fprintf(ellipseIncludeFile, "extern const AbEllipse ellipse%dx%d;\n", halfWidth, halfHeight);
+    }
+  }
+
+  fprintf(ellipseIncludeFile, "\n#endif // included \n");
+  fclose(ellipseIncludeFile);
+  return 0;
+}
@@ -0,0 +1,113 @@
+/** \file fmtbench.c
+ *  \brief Benchmark: formatting a 4 digit score with % and / (as
+ *  shapemotion.c did), with utoa10, and as a BCD counter.
+ *
+ *  On the msp430 ("make fmtbench-sim" or "make fmtbench-load") each
+ *  method's average cost in cycles is measured with Timer_A and left
+ *  in fmtCycles[] for mspdebug to read.  On a host ("make host-bench")
+ *  the time per call is printed; hosts divide in hardware, so only the
+ *  msp430 numbers show the cost of the missing divider.
+ */
+#include "numfmt.h"
+
+#define SAMPLES 100		/**< values formatted per method */
+
+/** The score loop formerly in shapemotion.c */
+static void
+divideLoop(int pts, char *str)
+{
+  int c = 3;
+  int temp = pts;
+  while (temp > 0) {
+    if (c < 0)
+      break;
+    int digit = temp % 10;
+    str[c] = digit + '0';
+    temp /= 10;
+    c -= 1;
+  }
+}
+
+static volatile int sample;	/**< keeps values opaque to the optimizer */
+static char str[6] = "    ";
+
+static void
+runDivide(int i)
+{
+  divideLoop(sample + i * 97, str);
+}
+
+static void
+runUtoa(int i)
+{
+  utoa10(sample + i * 97, str);
+}
+
+static void
+runBcd(int i)
+{
+  static unsigned int score;
+  (void)i;			/* same signature as the other methods */
+  bcdIncrement(&score);
+  bcdToString(score, str, 4);
+}
+
+static void (*const methods[3])(int i) = {runDivide, runUtoa, runBcd};
+
+#ifdef __MSP430__
+
+#include <msp430.h>
+
+unsigned int fmtCycles[3];	/**< average cycles per call: %/, utoa10, BCD */
+
+/** Reached when fmtCycles[] is complete (a breakpoint for the simulator) */
+void
+fmtDone()
+{
+}
+
+int
+main()
+{
+  unsigned char m;
+  int i;
+  WDTCTL = WDTPW | WDTHOLD;
+  TACTL = TASSEL_2 | MC_2 | TACLR;	/* count SMCLK (= MCLK) cycles */
+  for (m = 0; m < 3; m++) {
+    unsigned long total = 0;
+    for (i = 0; i < SAMPLES; i++) {
+      unsigned int start = TAR;	/* one call at a time: TAR is 16 bits */
+      methods[m](i);
+      total += TAR - start;
+    }
+    fmtCycles[m] = total / SAMPLES; /* (this divide isn't timed) */
+  }
+  fmtDone();
+  for (;;)
+    ;
+}
+
+#else
+
+#include <stdio.h>
+#include <time.h>
+
+#define ROUNDS 20000
+
+int
+main()
+{
+  static const char *names[3] = {"% and /", "utoa10", "bcd counter"};
+  int m, r, i;
+  for (m = 0; m < 3; m++) {
+    clock_t start = clock();
+    for (r = 0; r < ROUNDS; r++)
+      for (i = 0; i < SAMPLES; i++)
+	methods[m](i);
+    printf("%-12s %6.1f ns/call\n", names[m],
+	   1e9 * (clock() - start) / CLOCKS_PER_SEC / ROUNDS / SAMPLES);
+  }
+  return 0;
+}
+
+#endif
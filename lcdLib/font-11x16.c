@@ -287,3 +287,4 @@ const unsigned int font_11x16[95][11] = { 		// offset 0x20
   0x000C, 0x0004, 0x0000 		// ~
 };
 
+const Font font11x16 = {font_11x16, 11, 16, 0x20, 95, FONT_COLUMN_MAJOR | FONT_WIDE};
@@ -98,3 +98,5 @@ const unsigned char font_5x7[96][5] = {		// basic font
   , { 0x10, 0x08, 0x08, 0x10, 0x08 } // 7e ~
   , { 0x00, 0x06, 0x09, 0x09, 0x06 } // 7f Deg Symbol
 };
+
+const Font font5x7 = {font_5x7, 5, 8, 0x20, 96, FONT_COLUMN_MAJOR};
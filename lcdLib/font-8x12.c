@@ -285,3 +285,5 @@ const unsigned char font_8x12[95][12] = {	// offset 0x20
   0x00, 0x76, 0xDC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x00	 		// ~
 };
+
+const Font font8x12 = {font_8x12, 8, 12, 0x20, 95, FONT_MSB_FIRST};
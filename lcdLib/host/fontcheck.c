@@ -0,0 +1,91 @@
+/** \file fontcheck.c
+ *  \brief Host test: fonts written by makeFont against their sources.
+ *
+ *  "make host-check" runs makeFont for a subset (including '"' and
+ *  '\\', which must be escaped in the generated chars string) of each
+ *  font.  Every glyph's bits (found through the generated index) are
+ *  compared with the source font's, characters not in the subset must
+ *  give its first glyph, and the subset's characters drawn by
+ *  drawStringFont into the controller stand-in must match the same
+ *  string drawn in the source font.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "fontcheck5x7.h"
+#include "fontcheck8x12.h"
+#include "fontcheck11x16.h"
+#include "st7735.h"
+
+static u_int shown[screenHeight][screenWidth];
+
+// draw string in font at the top left; copy what is shown if save, else compare
+static int
+drawn(const char *string, const Font *font, int save)
+{
+  u_int width = fontStringWidth(font, string);
+  u_char col, row;
+  drawStringFont(0, 0, string, font, COLOR_WHITE, COLOR_BLUE);
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < font->height; row++)
+    for (col = 0; col < width; col++) {
+      if (save)
+	shown[row][col] = st7735_pixel(col, row);
+      else if (shown[row][col] != st7735_pixel(col, row)) {
+	printf("pixel %d,%d differs from the source font's\n", col, row);
+	return 0;
+      }
+    }
+  return 1;
+}
+
+static int
+check(const char *name, const Font *subset, const Font *source)
+{
+  char string[256];
+  int i;
+  u_char x, y;
+  memcpy(string, subset->chars, subset->numChars);
+  string[subset->numChars] = 0;
+  if (!strchr(string, '"') || !strchr(string, '\\')) {
+    printf("%s: '\"' or '\\' is missing from \"%s\"\n", name, string);
+    return 1;
+  }
+  for (i = 0; string[i]; i++) {
+    const u_char *glyph = fontGlyph(subset, string[i]);
+    const u_char *sourceGlyph = fontGlyph(source, string[i]);
+    for (y = 0; y < source->height; y++)
+      for (x = 0; x < source->width; x++)
+	if (fontBit(subset, glyph, x, y) != fontBit(source, sourceGlyph, x, y)) {
+	  printf("%s: '%c' differs at %d,%d\n", name, string[i], x, y);
+	  return 1;
+	}
+  }
+  if (fontGlyph(subset, 'A') != subset->glyphs || fontGlyph(subset, 0x7f) != subset->glyphs) {
+    printf("%s: a character not in the font is not drawn as the first\n", name);
+    return 1;
+  }
+  if (fontStringWidth(subset, string) != fontStringWidth(source, string)) {
+    printf("%s: string width differs\n", name);
+    return 1;
+  }
+  clearScreen(COLOR_BLACK);
+  if (!drawn(string, source, 1) || !drawn(string, subset, 0)) {
+    printf("%s: \"%s\" is drawn differently\n", name, string);
+    return 1;
+  }
+  printf("%s: %d characters match the source font\n", name, subset->numChars);
+  return 0;
+}
+
+int
+main()
+{
+  usci_sink = st7735_byte;
+  lcd_init();
+  return check("fontcheck5x7", &fontcheck5x7, &font5x7)
+    || check("fontcheck8x12", &fontcheck8x12, &font8x12)
+    || check("fontcheck11x16", &fontcheck11x16, &font11x16);
+}
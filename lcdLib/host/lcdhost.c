@@ -0,0 +1,62 @@
+/** \file lcdhost.c
+ *  \brief Prints the SPI byte stream produced by lcdLib drawing calls.
+ *
+ *  Built once with LCD_ASYNC=0 and once with LCD_ASYNC=1 by the 
+ *  "host-check" make production, which requires identical output.
+ */
+#include <stdio.h>
+#include "msp430.h"
+#include "sr.h"
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "usci.h"
+
+static void
+printByte(unsigned char byte, unsigned char isData)
+{
+  printf("%c %02x\n", isData ? 'D' : 'C', byte);
+}
+
+int
+main()
+{
+  usci_sink = printByte;
+  lcd_init();			/* interrupts still off: queue drained inline */
+  or_sr(GIE);
+  clearScreen(COLOR_BLUE);
+  fillRectangle(30, 30, 60, 60, COLOR_ORANGE);
+  drawString5x7(20, 20, "hello", COLOR_GREEN, COLOR_RED);
+  drawPixel(5, 6, COLOR_WHITE);
+  {
+    static u_char line[2][8] = {{1, 2, 3, 4, 5, 6, 7, 8}, {9, 10, 11, 12}};
+    lcd_setArea(0, 0, 5, 0);
+    lcd_writeBuffer(line[0], 8);
+    lcd_writeBuffer(line[1], 4);
+    lcd_waitBuffers(0);
+  }
+  drawPixel(6, 6, COLOR_WHITE);	/* same rows: PASET skipped */
+  drawChar5x7(40, 90, '0', COLOR_RED, COLOR_BLUE);
+  drawChar5x7(40, 90, '1', COLOR_RED, COLOR_BLUE); /* nothing resent */
+  drawStringFont(10, 100, "Ab1", &font8x12, COLOR_WHITE, COLOR_BLACK);
+  drawStringFontTransparent(10, 120, "Ab1", &font11x16, COLOR_YELLOW);
+  drawStringFontScaled(10, 60, "GO", &font5x7, 3, COLOR_RED, COLOR_BLACK);
+  {
+    static const u_char arrow[] = {0x10, 0x3f, 0xc4, 0x00}; /* 6x5 */
+    drawBitmap(100, 60, arrow, 6, 5, 2, COLOR_GREEN, COLOR_BLACK);
+  }
+  {
+    static char shown[4];
+    TextWidget score = {60, 140, &font5x7, COLOR_BLACK, COLOR_WHITE, shown, 4, 0};
+    textWidgetDraw(&score, "  19");
+    textWidgetDraw(&score, "  20");	/* two cells, one window */
+    textWidgetDraw(&score, "  20");	/* nothing sent */
+    textWidgetDraw(&score, " 1");	/* blanks the last two cells */
+  }
+  and_sr(~GIE);
+  drawString5x7(20, 40, "no GIE", COLOR_BLACK, COLOR_WHITE);
+  or_sr(GIE);
+  lcd_flush();
+  usci_drain();
+  printf("saved %lu\n", lcd_areaBytesSaved);
+  return 0;
+}
@@ -0,0 +1,48 @@
+/** \file msp430.h
+ *  \brief Host (Linux) stand-in for the msp430g2553 registers used by lcdLib.
+ *
+ *  Lets lcdutils.c and lcddraw.c be compiled with cc and exercised on a 
+ *  workstation.  Registers are plain variables defined in usci.c.
+ *  Transfers complete instantly: UCBUSY is never set and UCB0TXIFG is 
+ *  always set.  Each byte written to UCB0TXBUF is handed, along with the
+ *  state of the D/C line, to usci_sink.  See usci.c.
+ */
+
+#ifndef msp430_host_included
+#define msp430_host_included
+
+#define __interrupt_vec(vec)
+#define __delay_cycles(cycles) ((void)0)
+
+extern volatile unsigned char P1OUT, P1DIR, P1SEL, P1SEL2;
+extern volatile unsigned char UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT;
+extern volatile unsigned char IFG2, IE2;
+
+/** Writes to the tx buffer are captured (see usci.c) */
+volatile unsigned char *usci_txbuf();
+#define UCB0TXBUF (*usci_txbuf())
+
+#define BIT0 0x01
+#define BIT1 0x02
+#define BIT2 0x04
+#define BIT3 0x08
+#define BIT4 0x10
+#define BIT5 0x20
+#define BIT6 0x40
+#define BIT7 0x80
+
+#define GIE 0x0008
+
+#define UCSWRST 0x01
+#define UCSSEL_2 0x80
+#define UCCKPH 0x80
+#define UCMSB 0x20
+#define UCMST 0x08
+#define UCSYNC 0x01
+#define UCBUSY 0x01
+#define UCB0TXIFG 0x08
+#define UCB0TXIE 0x08
+
+#define USCIAB0TX_VECTOR 7
+
+#endif // included
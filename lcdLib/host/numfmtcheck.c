@@ -0,0 +1,70 @@
+/** \file numfmtcheck.c
+ *  \brief Host test: numfmt against printf.
+ *
+ *  utoa10 is checked for every value from 0 to 65535.  A BCD counter is
+ *  counted up from 0 through 9999 and its wrap to 0, then down
+ *  through its wrap to 9999 and back to 0, comparing each value and bcdToString's
+ *  text (at every width) with printf's.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "numfmt.h"
+
+// BCD encoding of n (0 to 9999), computed with division
+static unsigned int
+toBcd(int n)
+{
+  return (n / 1000 << 12) | (n / 100 % 10 << 8) | (n / 10 % 10 << 4) | (n % 10);
+}
+
+// compare bcd with n (0 to 9999) as a value and as text of each width
+static int
+checkBcd(unsigned int bcd, int n)
+{
+  static const int limit[5] = {1, 10, 100, 1000, 10000};
+  unsigned char digits;
+  if (bcd != toBcd(n)) {
+    printf("bcd counter is %04x, expected %d\n", bcd, n);
+    return 0;
+  }
+  for (digits = 1; digits <= 4; digits++) {
+    char string[5], expect[5];
+    bcdToString(bcd, string, digits);
+    sprintf(expect, "%*d", digits, n % limit[digits]);
+    if (strcmp(string, expect)) {
+      printf("bcdToString(%04x, %d) is \"%s\", expected \"%s\"\n", bcd, digits, string, expect);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int
+main()
+{
+  unsigned int value, bcd = 0;
+  int n;
+  for (value = 0; value <= 65535; value++) {
+    char string[6], expect[6];
+    unsigned char len = utoa10(value, string);
+    sprintf(expect, "%u", value);
+    if (strcmp(string, expect) || len != strlen(expect)) {
+      printf("utoa10(%u) is \"%s\" (%d), expected \"%s\"\n", value, string, len, expect);
+      return 1;
+    }
+  }
+  if (!checkBcd(bcd, 0))
+    return 1;
+  for (n = 1; n <= 10000; n++) { /* up, and 9999 wraps to 0 */
+    bcdIncrement(&bcd);
+    if (!checkBcd(bcd, n % 10000))
+      return 1;
+  }
+  for (n = 9999; n >= 0; n--) {	/* 0 wraps to 9999, then down to 0 */
+    bcdDecrement(&bcd);
+    if (!checkBcd(bcd, n))
+      return 1;
+  }
+  printf("numfmt: utoa10 and the BCD counter match printf\n");
+  return 0;
+}
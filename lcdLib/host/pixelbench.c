@@ -0,0 +1,94 @@
+/** \file pixelbench.c
+ *  \brief Host benchmark: SPI bytes per pixel for drawPixel and drawPixels.
+ *
+ *  Draws the same frames of scattered "sparkles" and short horizontal
+ *  "trails" pixel by pixel and as batches, counting the bytes sent.
+ *  Also compares the bytes per frame of redrawing a score with
+ *  drawString5x7 and with a TextWidget.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "msp430.h"
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "usci.h"
+
+#define FRAMES 100
+#define BATCH_SIZE 64
+
+static Pixel pixels[BATCH_SIZE];
+static PixelBatch batch = {pixels, 0, BATCH_SIZE};
+
+/** Fill batch with a frame: sparkles, or trails of 8 pixels */
+static void
+makeFrame(int trails)
+{
+  batch.count = 0;
+  while (batch.count < BATCH_SIZE) {
+    u_char col = rand() % (screenWidth - 8), row = rand() % screenHeight, i;
+    if (!trails)
+      pixelBatchAdd(&batch, col, row, COLOR_WHITE);
+    else
+      for (i = 0; i < 8; i++)
+	pixelBatchAdd(&batch, col + i, row, i < 4 ? COLOR_YELLOW : COLOR_RED);
+  }
+}
+
+static void
+report(const char *name, int trails)
+{
+  unsigned long single = 0, batched = 0, pixelCount = 0, start;
+  int frame, i;
+  srand(1);
+  for (frame = 0; frame < FRAMES; frame++) {
+    makeFrame(trails);
+    pixelCount += batch.count;
+    start = usci_bytesSent;
+    for (i = 0; i < batch.count; i++)
+      drawPixel(pixels[i].col, pixels[i].row, pixels[i].colorBGR);
+    lcd_flush();
+    single += usci_bytesSent - start;
+    start = usci_bytesSent;
+    drawPixels(&batch);
+    lcd_flush();
+    batched += usci_bytesSent - start;
+  }
+  printf("%-9s drawPixel %5.2f bytes/pixel  drawPixels %5.2f bytes/pixel\n",
+	 name, (double)single / pixelCount, (double)batched / pixelCount);
+}
+
+/** A 4 digit score, drawn every frame and incremented every 8th */
+static void
+reportScore()
+{
+  static char shown[4];
+  TextWidget widget = {64, 140, &font5x7, COLOR_BLACK, COLOR_WHITE, shown, 4, 0};
+  unsigned long whole = 0, changed = 0, start;
+  char score[5] = "   0";
+  int frame, c;
+  for (frame = 0; frame < FRAMES; frame++) {
+    if (frame && !(frame & 7))
+      for (c = 3; c >= 0 && ++score[c] > '9'; c--)
+	score[c] = '0';		/* ripple the carry */
+    start = usci_bytesSent;
+    drawString5x7(64, 140, score, COLOR_BLACK, COLOR_WHITE);
+    lcd_flush();
+    whole += usci_bytesSent - start;
+    start = usci_bytesSent;
+    textWidgetDraw(&widget, score);
+    lcd_flush();
+    changed += usci_bytesSent - start;
+  }
+  printf("score     drawString5x7 %5.1f bytes/frame  textWidgetDraw %5.1f bytes/frame\n",
+	 (double)whole / FRAMES, (double)changed / FRAMES);
+}
+
+int
+main()
+{
+  lcd_init();
+  report("sparkles", 0);
+  report("trails", 1);
+  reportScore();
+  return 0;
+}
@@ -0,0 +1,123 @@
+/** \file scalecheck.c
+ *  \brief Host test: magnified text and bitmaps against unscaled bits.
+ *
+ *  drawStringFontScaled (every font, scales 1 to 4 and 8) and
+ *  drawBitmap (an odd-sized bitmap, scales 1 to 3) draw into the
+ *  controller stand-in over a screen of another color.  Each pixel in
+ *  the drawn area must be the color of the font or bitmap bit it
+ *  magnifies, the gaps between characters must be background, and
+ *  the pixels around the area must be untouched.  Both are also drawn
+ *  across the bottom right corner, where the rows (and the bitmap's
+ *  columns, down to part of a magnified bit) must be clipped to the
+ *  screen rather than wrap around it.
+ */
+#include <stdio.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "st7735.h"
+
+#define COL 3
+#define ROW 5
+#define FG COLOR_WHITE
+#define BG COLOR_BLUE
+#define SCREEN COLOR_RED
+
+/** Bit (x, y) of the magnified picture being checked */
+typedef u_char (*BitAt)(const void *what, int x, int y);
+
+static const char *string = "Ab\"9";
+
+static u_char
+textBit(const void *font, int x, int y)
+{
+  const Font *f = font;
+  int c = x / (f->width + 1);
+  x -= c * (f->width + 1);
+  return x < f->width && fontBit(f, fontGlyph(f, string[c]), x, y);
+}
+
+#define BITMAP_WIDTH 13
+#define BITMAP_HEIGHT 7
+
+static u_char bitmap[(BITMAP_WIDTH * BITMAP_HEIGHT + 7) / 8];
+
+static u_char
+bitmapBit(const void *bits, int x, int y)
+{
+  int i = y * BITMAP_WIDTH + x;
+  return (((const u_char *)bits)[i >> 3] >> (7 - (i & 7))) & 1;
+}
+
+// compare the panel with width x height bits magnified by scale at col0, row0
+static int
+check(const char *name, BitAt bitAt, const void *what, int width, int height, int scale,
+      int col0, int row0)
+{
+  int col, row;
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++) {
+      int x = col - col0, y = row - row0;
+      u_int expect = SCREEN;
+      if (x >= 0 && y >= 0 && x < width * scale && y < height * scale)
+	expect = (*bitAt)(what, x / scale, y / scale) ? FG : BG;
+      if (st7735_pixel(col, row) != expect) {
+	printf("%s scale %d: pixel %d,%d is %04x, expected %04x\n", name, scale,
+	       col, row, st7735_pixel(col, row), expect);
+	return 1;
+      }
+    }
+  return 0;
+}
+
+int
+main()
+{
+  static const Font *fonts[] = {&font5x7, &font8x12, &font11x16};
+  static const char *names[] = {"font5x7", "font8x12", "font11x16"};
+  static const u_char scales[] = {1, 2, 3, 4, 8};
+  int f, s, i;
+  usci_sink = st7735_byte;
+  lcd_init();
+  for (f = 0; f < 3; f++)
+    for (s = 0; s < 5; s++) {
+      const Font *font = fonts[f];
+      int width = fontStringWidth(font, string);
+      if (COL + width * scales[s] > screenWidth || ROW + font->height * scales[s] > screenHeight)
+	continue;		/* doesn't fit */
+      clearScreen(SCREEN);
+      drawStringFontScaled(COL, ROW, string, font, scales[s], FG, BG);
+      if (check(names[f], textBit, font, width, font->height, scales[s], COL, ROW))
+	return 1;
+    }
+  for (f = 0; f < 3; f++) {	/* rows past the bottom */
+    const Font *font = fonts[f];
+    int advance = font->width + 1, len = 0;
+    while (string[len] && COL + 8 * (advance * len + font->width) <= screenWidth)
+      len++;			/* whole characters across the screen */
+    clearScreen(SCREEN);
+    drawStringFontScaled(COL, screenHeight - 9, string, font, 8, FG, BG);
+    if (check(names[f], textBit, font, advance * len - 1, font->height, 8,
+	      COL, screenHeight - 9))
+      return 1;
+  }
+  for (i = 0; i < sizeof(bitmap); i++)
+    bitmap[i] = 0x5a ^ (i * 37);
+  for (s = 1; s <= 3; s++) {
+    clearScreen(SCREEN);
+    drawBitmap(COL, ROW, bitmap, BITMAP_WIDTH, BITMAP_HEIGHT, s, FG, BG);
+    if (check("bitmap", bitmapBit, bitmap, BITMAP_WIDTH, BITMAP_HEIGHT, s, COL, ROW))
+      return 1;
+  }
+  for (s = 1; s <= 8; s++) {	/* across the bottom right corner */
+    clearScreen(SCREEN);
+    drawBitmap(screenWidth - 20, screenHeight - 10, bitmap, BITMAP_WIDTH, BITMAP_HEIGHT, s,
+	       FG, BG);
+    if (check("clipped bitmap", bitmapBit, bitmap, BITMAP_WIDTH, BITMAP_HEIGHT, s,
+	      screenWidth - 20, screenHeight - 10))
+      return 1;
+  }
+  printf("scaled text and bitmaps match their unscaled bits\n");
+  return 0;
+}
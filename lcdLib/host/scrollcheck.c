@@ -0,0 +1,82 @@
+/** \file scrollcheck.c
+ *  \brief Checks hardware scrolling against the controller stand-in.
+ *
+ *  Draws a pattern, scrolls a band through every offset and verifies
+ *  what the panel shows, then redraws a line through lcd_scrollAddress.
+ */
+#include <stdio.h>
+#include "msp430.h"
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "st7735.h"
+
+#define FIRST 20
+#define COUNT 100
+
+/** color shown for colorBGR */
+#if LCD_COLOR_BITS == 12
+# define SHOWN(colorBGR) bgr2c12(colorBGR)
+#else
+# define SHOWN(colorBGR) (colorBGR)
+#endif
+
+static u_int
+pattern(u_char col, u_char row)
+{
+  return (col << 8) | row;
+}
+
+/** row (column) along the scroll axis of col, row */
+#define AXIS_POS(col, row) (LCD_SCROLL_AXIS ? (row) : (col))
+
+static int
+check(u_char offset, u_char redrawn)
+{
+  u_char col, row;
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++) {
+      u_char pos = AXIS_POS(col, row);
+      u_int expect;
+      if (pos == redrawn)
+	expect = SHOWN(COLOR_WHITE);
+      else if (pos >= FIRST && pos < FIRST + COUNT) { /* scrolled */
+	u_char src = FIRST + (pos - FIRST + offset) % COUNT;
+	expect = SHOWN(LCD_SCROLL_AXIS ? pattern(col, src) : pattern(src, row));
+      } else
+	expect = SHOWN(pattern(col, row));
+      if (st7735_pixel(col, row) != expect) {
+	printf("offset %d: pixel %d,%d is %04x, expected %04x\n", offset, 
+	       col, row, st7735_pixel(col, row), expect);
+	return 1;
+      }
+    }
+  return 0;
+}
+
+int
+main()
+{
+  u_char col, row, offset, addr;
+  usci_sink = st7735_byte;
+  lcd_init();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++)
+      drawPixel(col, row, pattern(col, row));
+  lcd_setScrollArea(FIRST, COUNT);
+  for (offset = 0; offset < COUNT; offset++) {
+    lcd_scrollTo(offset);
+    if (check(offset, 0xff))
+      return 1;
+  }
+  addr = lcd_scrollAddress(FIRST + 3);	/* a line that appears at FIRST+3 */
+  if (LCD_SCROLL_AXIS)
+    fillRectangle(0, addr, screenWidth, 1, COLOR_WHITE);
+  else
+    fillRectangle(addr, 0, 1, screenHeight, COLOR_WHITE);
+  if (check(COUNT - 1, FIRST + 3))
+    return 1;
+  printf("orientation %d ok\n", ORIENTATION);
+  return 0;
+}
@@ -0,0 +1,118 @@
+/** \file st7735.c
+ *  \brief Host stand-in for the ST7735 controller's frame memory.
+ *
+ *  Decodes the bytes lcdLib sends (e.g. as usci_sink) into a 128x160
+ *  frame memory, honouring CASET, PASET, RAMWR, MADCTL (MX, MY and MV),
+ *  COLMOD (16 or 12 bits per pixel) and the vertical scroll registers
+ *  (SCRLAR, VSCSAD).  st7735_pixel returns what the panel would show
+ *  (as sent: BGR565, or 12 bit color), so drawing and scrolling can be
+ *  checked without a display.
+ */
+#include "lcdutils.h"
+#include "st7735.h"
+
+#define MEM_COLS SHORT_EDGE_PIXELS
+#define MEM_LINES LONG_EDGE_PIXELS
+
+static u_int mem[MEM_LINES][MEM_COLS];
+static u_char command, params[6], numParams;
+static u_char madctl = 0, colmod = 0x05;
+static unsigned long pixelBits;	/**< bits of the pixel being received */
+static u_char numBits;
+static u_int colStart, colEnd, rowStart, rowEnd, col, row;
+static u_int tfa = 0, vsa = MEM_LINES, ssa = 0;
+
+/** Map controller (column, row) address to frame memory (x, line) */
+static void
+st7735_map(u_int c, u_int r, u_int *x, u_int *line)
+{
+  if (madctl & 0x20) {		/* MV: exchange rows and columns */
+    u_int t = c;
+    c = r;
+    r = t;
+  }
+  *x = (madctl & 0x40) ? MEM_COLS - 1 - c : c; /* MX */
+  *line = (madctl & 0x80) ? MEM_LINES - 1 - r : r; /* MY */
+}
+
+static u_int
+word(u_char i)
+{
+  return (params[i] << 8) | params[i+1];
+}
+
+/** Receive one byte sent to the controller */
+void
+st7735_byte(unsigned char byte, unsigned char isData)
+{
+  if (!isData) {
+    command = byte;
+    numParams = numBits = 0;	/* partial pixels are dropped */
+    if (command == 0x2c) {	/* RAMWR */
+      col = colStart;
+      row = rowStart;
+    }
+    return;
+  }
+  if (command == 0x2c) {
+    u_int x, line;
+    u_char bpp = (colmod == 0x03) ? 12 : 16;
+    pixelBits = (pixelBits << 8) | byte;
+    numBits += 8;
+    if (numBits < bpp)
+      return;
+    numBits -= bpp;		/* pixel complete */
+    st7735_map(col, row, &x, &line);
+    if (x < MEM_COLS && line < MEM_LINES)
+      mem[line][x] = (pixelBits >> numBits) & ((1L << bpp) - 1);
+    if (++col > colEnd) {
+      col = colStart;
+      if (++row > rowEnd)
+	row = rowStart;
+    }
+    return;
+  }
+  if (numParams < sizeof(params))
+    params[numParams++] = byte;
+  switch (command) {
+  case 0x2a:			/* CASET */
+    if (numParams == 4) {
+      colStart = word(0);
+      colEnd = word(2);
+    }
+    break;
+  case 0x2b:			/* PASET */
+    if (numParams == 4) {
+      rowStart = word(0);
+      rowEnd = word(2);
+    }
+    break;
+  case 0x33:			/* SCRLAR */
+    if (numParams == 6) {
+      tfa = word(0);
+      vsa = word(2);
+    }
+    break;
+  case 0x37:			/* VSCSAD */
+    if (numParams == 2)
+      ssa = word(0);
+    break;
+  case 0x36:			/* MADCTL */
+    madctl = byte;
+    break;
+  case 0x3a:			/* COLMOD */
+    colmod = byte;
+    break;
+  }
+}
+
+/** Color shown at col, row (screen coordinates of the current MADCTL) */
+u_int
+st7735_pixel(u_char c, u_char r)
+{
+  u_int x, line;
+  st7735_map(c, r, &x, &line);
+  if (line >= tfa && line < tfa + vsa) /* scrolling area */
+    line = tfa + (line - tfa + ssa - tfa) % vsa;
+  return mem[line][x];
+}
@@ -0,0 +1,21 @@
+/** \file st7735.h
+ *  \brief Host stand-in for the ST7735 controller's frame memory.
+ *
+ *  Tests draw with "usci_sink = st7735_byte", then lcd_flush() and
+ *  usci_drain(), and read the panel back with st7735_pixel.  See 
+ *  st7735.c.
+ */
+
+#ifndef st7735_host_included
+#define st7735_host_included
+
+#include "lcdutils.h"
+#include "usci.h"
+
+/** Receive one byte sent to the controller */
+void st7735_byte(unsigned char byte, unsigned char isData);
+
+/** Color shown at col, row (screen coordinates of the current MADCTL) */
+u_int st7735_pixel(u_char col, u_char row);
+
+#endif // included
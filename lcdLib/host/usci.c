@@ -0,0 +1,67 @@
+/** \file usci.c
+ *  \brief Host stand-in for USCI_B0, port 1 and the status register.
+ *
+ *  Interrupts: whenever the status register is read with GIE set, one
+ *  pending USCI_B0 TX interrupt (UCB0TXIE set) is delivered to lcd_txIsr
+ *  if it is linked in.  Busy-wait loops that poll get_sr() therefore
+ *  see the queue drain just as they would on the device.
+ */
+#include <stddef.h>
+#include "msp430.h"
+#include "sr.h"
+#include "usci.h"
+
+volatile unsigned char P1OUT, P1DIR, P1SEL, P1SEL2;
+volatile unsigned char UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT;
+volatile unsigned char IFG2 = UCB0TXIFG, IE2;
+
+/** Receives each byte sent and whether D/C was high (data) */
+void (*usci_sink)(unsigned char byte, unsigned char isData) = NULL;
+
+/** Bytes sent so far */
+unsigned long usci_bytesSent = 0;
+
+static volatile unsigned char txSlot;
+static unsigned char txPending = 0, txPendingData;
+
+/** Deliver a byte written to txSlot that has not been reported yet */
+void
+usci_drain()
+{
+  if (txPending) {
+    txPending = 0;
+    usci_bytesSent++;
+    if (usci_sink)
+      (*usci_sink)(txSlot, txPendingData);
+  }
+}
+
+/* The byte is stored after this returns, so it is reported by the next
+   write or usci_drain().  D/C is sampled now, as the device does. */
+volatile unsigned char *
+usci_txbuf()
+{
+  usci_drain();
+  txPending = 1;
+  txPendingData = (P1OUT & BIT4) != 0;
+  return &txSlot;
+}
+
+extern void lcd_txIsr() __attribute__((weak));
+
+static int sr = 0;
+
+void set_sr(int sr_val) { sr = sr_val; }
+void or_sr(int or_val) { sr |= or_val; }
+void and_sr(int and_val) { sr &= and_val; }
+
+int
+get_sr()
+{
+  if ((sr & GIE) && (IE2 & UCB0TXIE) && (IFG2 & UCB0TXIFG) && lcd_txIsr) {
+    sr &= ~GIE;			/* handlers run with interrupts off */
+    lcd_txIsr();
+    sr |= GIE;
+  }
+  return sr;
+}
@@ -0,0 +1,21 @@
+/** \file usci.h
+ *  \brief Host stand-in for USCI_B0: where the bytes lcdLib sends go.
+ *
+ *  See usci.c.
+ */
+
+#ifndef usci_host_included
+#define usci_host_included
+
+/** Receives each byte sent and whether D/C was high (data) */
+extern void (*usci_sink)(unsigned char byte, unsigned char isData);
+
+/** Bytes sent so far */
+extern unsigned long usci_bytesSent;
+
+/** Deliver a byte written to the transmit buffer that has not been 
+ *  reported yet (call after lcd_flush() before reading what was sent)
+ */
+void usci_drain();
+
+#endif // included
@@ -0,0 +1,92 @@
+/** \file widgetcheck.c
+ *  \brief Host test: differential text widgets against whole redraws.
+ *
+ *  Runs sequences of strings through textWidgetDraw (growing,
+ *  shrinking, blanked and unchanged cells, strings longer than the
+ *  widget, and a widget clipped by the screen's edge) and after each
+ *  one compares the controller stand-in's panel with a fresh screen
+ *  where drawStringFont drew the last string once, padded with blanks
+ *  over every cell the widget has shown.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "st7735.h"
+
+#define FG COLOR_BLACK
+#define BG COLOR_WHITE
+#define SCREEN COLOR_BLUE
+#define SIZE 6			/**< cells in each widget */
+
+static const char *steps[] = {
+  "1", "12", "1234", "1334", "13", "", "  20", "  21", "  21",
+  "abcdefgh", "abcxef", "x", "", "xyz",
+};
+
+static u_int panel[160][160];	/**< what the widget left */
+
+/** Compare the panel with one drawStringFont of string, padded with
+ *  blanks to shownLen cells, at the widget's position */
+static int
+check(const char *name, const TextWidget *widget, const char *string, u_char shownLen)
+{
+  char padded[SIZE + 1];
+  u_char col, row, len = strlen(string);
+  if (len > SIZE)
+    len = SIZE;
+  memset(padded, ' ', SIZE);
+  memcpy(padded, string, len);
+  padded[shownLen] = 0;
+  clearScreen(SCREEN);
+  drawStringFont(widget->col, widget->row, padded, widget->font, FG, BG);
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++)
+      if (panel[row][col] != st7735_pixel(col, row)) {
+	printf("%s \"%s\": pixel %d,%d is %04x, expected %04x\n", name, string,
+	       col, row, panel[row][col], st7735_pixel(col, row));
+	return 1;
+      }
+  return 0;
+}
+
+/** Draw steps[0] through steps[last] in a widget on a fresh screen,
+ *  then compare with a whole redraw of steps[last] */
+static int
+run(const char *name, u_char col, u_char row, const Font *font, u_char last)
+{
+  static char shown[SIZE];
+  TextWidget widget = {col, row, font, FG, BG, shown, SIZE, 0};
+  u_char i, shownLen = 0;
+  clearScreen(SCREEN);
+  for (i = 0; i <= last; i++) {
+    u_char len = strlen(steps[i]);
+    if (len > shownLen)
+      shownLen = len > SIZE ? SIZE : len;
+    textWidgetDraw(&widget, steps[i]);
+  }
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++)
+      panel[row][col] = st7735_pixel(col, row);
+  return check(name, &widget, steps[last], shownLen);
+}
+
+int
+main()
+{
+  u_char last;
+  usci_sink = st7735_byte;
+  lcd_init();
+  for (last = 0; last < sizeof(steps) / sizeof(*steps); last++)
+    if (run("font5x7", 4, 20, &font5x7, last)
+	|| run("font8x12", 10, 60, &font8x12, last)
+	|| run("font11x16", 30, 100, &font11x16, last)
+	|| run("clipped font8x12", screenWidth - 30, 140, &font8x12, last))
+      return 1;
+  printf("text widgets match whole redraws\n");
+  return 0;
+}
@@ -4,6 +4,9 @@
 #include "lcdutils.h"
 #include "lcddraw.h"
 
+/** Number of color runs drawStringFont buffers before writing them */
+#define STRING_RUN_BUFFER 8
+
 
 /** Draw single pixel at x,row 
  *
@@ -17,6 +20,56 @@ void drawPixel(u_char col, u_char row, u_int colorBGR)
   lcd_writeColor(colorBGR);
 }
 
+/** Add pixel at col,row to batch, keeping it sorted by row then col
+ *  (insertion: batches are small)
+ */
+u_char pixelBatchAdd(PixelBatch *batch, u_char col, u_char row, u_int colorBGR)
+{
+  u_int key = (row << 8) | col;
+  u_char i = batch->count;
+  Pixel *p;
+  while (i) {			/* find first pixel after key */
+    p = &batch->pixels[i - 1];
+    u_int pKey = (p->row << 8) | p->col;
+    if (pKey == key) {
+      p->colorBGR = colorBGR;
+      return 1;
+    }
+    if (pKey < key)
+      break;
+    i--;
+  }
+  if (batch->count == batch->size)
+    return 0;
+  for (p = &batch->pixels[batch->count]; p > &batch->pixels[i]; p--)
+    p[0] = p[-1];
+  p->col = col;
+  p->row = row;
+  p->colorBGR = colorBGR;
+  batch->count++;
+  return 1;
+}
+
+/** Draw batch, one window per run of horizontally adjacent pixels
+ */
+void drawPixels(const PixelBatch *batch)
+{
+  const Pixel *p = batch->pixels, *end = p + batch->count, *run;
+  while (p < end) {
+    for (run = p + 1;
+	 run < end && run->row == p->row && run->col == run[-1].col + 1; run++)
+      ;
+    lcd_setArea(p->col, p->row, run[-1].col, p->row);
+    while (p < run) {
+      u_char count = 1;
+      while (p + count < run && p[count].colorBGR == p->colorBGR)
+	count++;
+      lcd_writeColorRun(p->colorBGR, count);
+      p += count;
+    }
+  }
+}
+
 /** Fill rectangle
  *
  *  \param colMin Column start
@@ -30,11 +83,7 @@ void fillRectangle(u_char colMin, u_char rowMin, u_char width, u_char height,
 {
   u_char colLimit = colMin + width, rowLimit = rowMin + height;
   lcd_setArea(colMin, rowMin, colLimit - 1, rowLimit - 1);
-  u_int total = width * height;
-  u_int c = 0;
-  while ((c++) < total) {
-    lcd_writeColor(colorBGR);
-  }
+  lcd_writeColorRun(colorBGR, width * height);
 }
 
 /** Clear screen (fill with color)
@@ -43,9 +92,8 @@ void fillRectangle(u_char colMin, u_char rowMin, u_char width, u_char height,
  */
 void clearScreen(u_int colorBGR) 
 {
-  u_char w = screenWidth;
-  u_char h = screenHeight;
-  fillRectangle(0, 0, screenWidth, screenHeight, colorBGR);
+  lcd_setArea(0, 0, screenWidth - 1, screenHeight - 1);
+  lcd_writeColorRun(colorBGR, screenWidth * screenHeight);
 }
 
 /** 5x7 font - this function draws background pixels
@@ -54,25 +102,289 @@ void clearScreen(u_int colorBGR)
 void drawChar5x7(u_char rcol, u_char rrow, char c, 
      u_int fgColorBGR, u_int bgColorBGR) 
 {
-  u_char col = 0;
-  u_char row = 0;
-  u_char bit = 0x01;
-  u_char oc = c - 0x20;
-
   lcd_setArea(rcol, rrow, rcol + 4, rrow + 7); /* relative to requested col/row */
-  while (row < 8) {
-    while (col < 5) {
-      u_int colorBGR = (font_5x7[oc][col] & bit) ? fgColorBGR : bgColorBGR;
-      lcd_writeColor(colorBGR);
-      col++;
+  lcd_writeGlyph5x7(c, fgColorBGR, bgColorBGR);
+}
+
+/** Glyph of character c in font (firstChar's, or the first packed
+ *  glyph, if c is not in font)
+ */
+const u_char *fontGlyph(const Font *font, char c)
+{
+  u_char i = (u_char)c - font->firstChar;
+  u_int units = (font->flags & FONT_COLUMN_MAJOR) ? font->width : font->height;
+  if (font->flags & FONT_PACKED) {
+    const u_char *glyph = font->glyphs;
+    units = (font->width * font->height + 7) >> 3; /* bytes per glyph */
+    if (font->index)		/* direct lookup */
+      return i <= (u_char)(font->lastChar - font->firstChar)
+	? glyph + font->index[i] * units : glyph;
+    for (i = 0; i < font->numChars; i++, glyph += units)
+      if (font->chars[i] == c)
+	return glyph;
+    return font->glyphs;
+  }
+  if (i >= font->numChars)
+    i = 0;
+  if (font->flags & FONT_WIDE)
+    return (const u_char *)((const u_int *)font->glyphs + i * units);
+  return (const u_char *)font->glyphs + i * units;
+}
+
+/** Is pixel x,y of glyph set? */
+u_char fontBit(const Font *font, const u_char *glyph, u_char x, u_char y)
+{
+  u_char unit = y, bit = x;
+  u_int bits;
+  if (font->flags & FONT_PACKED) {
+    bits = y * font->width + x;	/* bit number */
+    return (glyph[bits >> 3] >> (7 - (bits & 7))) & 1;
+  }
+  if (font->flags & FONT_COLUMN_MAJOR) {
+    unit = x;
+    bit = y;
+  }
+  if (font->flags & FONT_WIDE) {
+    bits = ((const u_int *)glyph)[unit];
+    if (font->flags & FONT_MSB_FIRST)
+      bit = 15 - bit;
+  } else {
+    bits = glyph[unit];
+    if (font->flags & FONT_MSB_FIRST)
+      bit = 7 - bit;
+  }
+  return (bits >> bit) & 1;
+}
+
+/** Number of characters of string that fit on screen starting at col */
+static u_char fontFit(const Font *font, u_char col, const char *string)
+{
+  u_char len = 0, advance = font->width + 1;
+  while (string[len] && col + advance * len + font->width - 1 < screenWidth)
+    len++;
+  return len;
+}
+
+/** Width in pixels of string drawn in font (1 pixel between characters) */
+u_int fontStringWidth(const Font *font, const char *string)
+{
+  u_int len = 0;
+  while (string[len])
+    len++;
+  return len ? len * (font->width + 1) - 1 : 0;
+}
+
+/** Append count pixels of color to the runs being streamed,
+ *  writing the buffered runs when it is full
+ */
+static void addRun(ColorSpan runs[], u_char *numRuns, u_int color, u_char count)
+{
+  if (*numRuns) {
+    ColorSpan *last = &runs[*numRuns - 1];
+    if (last->colorBGR == color && last->count <= 255 - count) {
+      last->count += count;	/* continues previous run */
+      return;
+    }
+  }
+  if (*numRuns == STRING_RUN_BUFFER) {
+    lcd_writeColorSpans(runs, *numRuns);
+    *numRuns = 0;
+  }
+  runs[*numRuns].colorBGR = color;
+  runs[(*numRuns)++].count = count;
+}
+
+/** Stream width bits of bits, from bit number bit on (MSB first), each
+ *  as a run of scale pixels
+ */
+static void addScaledRow(ColorSpan runs[], u_char *numRuns, const u_char *bits,
+			 u_int bit, u_char width, u_char scale,
+			 u_int fgColorBGR, u_int bgColorBGR)
+{
+  for (; width; width--, bit++)
+    addRun(runs, numRuns, (bits[bit >> 3] & (0x80 >> (bit & 7)))
+	   ? fgColorBGR : bgColorBGR, scale);
+}
+
+/** Draw the len characters at chars, starting at col,row in font,
+ *  through one window (gaps between them included)
+ */
+static void drawFontChars(u_char col, u_char row, const char *chars, u_char len,
+			  const Font *font, u_int fgColorBGR, u_int bgColorBGR)
+{
+  ColorSpan runs[STRING_RUN_BUFFER];
+  u_char numRuns = 0, i, x, y;
+  u_char width = font->width;
+  if (!len)
+    return;
+  lcd_setArea(col, row, col + (width + 1) * len - 2, row + font->height - 1);
+  for (y = 0; y < font->height; y++) {	/* each pixel row */
+    for (i = 0; i < len; i++) {
+      const u_char *glyph = fontGlyph(font, chars[i]);
+      for (x = 0; x <= width; x++) {
+	u_int color;
+	if (x == width && i == len - 1)
+	  break;		/* no gap after last character */
+	color = (x < width && fontBit(font, glyph, x, y)) ? fgColorBGR : bgColorBGR;
+	addRun(runs, &numRuns, color, 1);
+      }
+    }
+  }
+  lcd_writeColorSpans(runs, numRuns);
+}
+
+/** Draw string at col,row in font through one window, gaps included
+ *
+ *  \param col Column to start drawing string
+ *  \param row Row to start drawing string
+ *  \param string The string
+ *  \param font The font
+ *  \param fgColorBGR Foreground color in BGR
+ *  \param bgColorBGR Background color in BGR
+ */
+void drawStringFont(u_char col, u_char row, const char *string, const Font *font,
+		    u_int fgColorBGR, u_int bgColorBGR)
+{
+  drawFontChars(col, row, string, fontFit(font, col, string), font,
+		fgColorBGR, bgColorBGR);
+}
+
+/** Draw string at col,row in font, each pixel scale x scale
+ *
+ *  Each row of the string is decoded from the font once, into a row of
+ *  bits, then streamed scale times through one window.
+ */
+void drawStringFontScaled(u_char col, u_char row, const char *string,
+			  const Font *font, u_char scale,
+			  u_int fgColorBGR, u_int bgColorBGR)
+{
+  u_char rowBits[(screenWidth + 7) >> 3];
+  ColorSpan runs[STRING_RUN_BUFFER];
+  u_char advance = font->width + 1, len = 0, numRuns = 0, width, lines, i, x, y;
+  while (string[len]
+	 && col + scale * (advance * len + font->width) - 1 < screenWidth)
+    len++;			/* characters that fit on screen */
+  if (!len || row >= screenHeight)
+    return;
+  width = advance * len - 1;	/* unscaled, no gap after last character */
+  lines = screenHeight - row;	/* pixel rows that fit on screen */
+  if (scale * font->height < lines)
+    lines = scale * font->height;
+  lcd_setArea(col, row, col + scale * width - 1, row + lines - 1);
+  for (y = 0; lines; y++) {
+    u_char bit = 0, repeat;
+    for (i = 0; i < sizeof(rowBits); i++)
+      rowBits[i] = 0;
+    for (i = 0; i < len; i++, bit++) {	/* bit++: gap */
+      const u_char *glyph = fontGlyph(font, string[i]);
+      for (x = 0; x < font->width; x++, bit++)
+	if (fontBit(font, glyph, x, y))
+	  rowBits[bit >> 3] |= 0x80 >> (bit & 7);
     }
-    col = 0;
-    bit <<= 1;
-    row++;
+    for (repeat = scale; repeat && lines; repeat--, lines--)
+      addScaledRow(runs, &numRuns, rowBits, 0, width, scale, fgColorBGR, bgColorBGR);
   }
+  lcd_writeColorSpans(runs, numRuns);
 }
 
-/** Draw string at col,row
+/** Draw a width x height 1 bit bitmap at col,row, each pixel scale x scale,
+ *  clipped to the screen (the last bit of a row may be partly shown)
+ */
+void drawBitmap(u_char col, u_char row, const u_char *bits, u_char width,
+		u_char height, u_char scale, u_int fgColorBGR, u_int bgColorBGR)
+{
+  ColorSpan runs[STRING_RUN_BUFFER];
+  u_char numRuns = 0, repeat, cols, lines, shown, rest;
+  u_int bit = 0;
+  if (col >= screenWidth || row >= screenHeight)
+    return;
+  cols = screenWidth - col;	/* pixel columns and rows that fit on screen */
+  if (scale * width < cols)
+    cols = scale * width;
+  lines = screenHeight - row;
+  if (scale * height < lines)
+    lines = scale * height;
+  if (!cols || !lines)
+    return;
+  shown = cols / scale;		/* whole bits of each row */
+  rest = cols - shown * scale;	/* pixels of the bit after them */
+  lcd_setArea(col, row, col + cols - 1, row + lines - 1);
+  for (; lines; bit += width)
+    for (repeat = scale; repeat && lines; repeat--, lines--) {
+      addScaledRow(runs, &numRuns, bits, bit, shown, scale, fgColorBGR, bgColorBGR);
+      if (rest)
+	addScaledRow(runs, &numRuns, bits, bit + shown, 1, rest, fgColorBGR, bgColorBGR);
+    }
+  lcd_writeColorSpans(runs, numRuns);
+}
+
+/** Draw only the set pixels of string at col,row in font,
+ *  one window per horizontal span of each glyph row
+ */
+void drawStringFontTransparent(u_char col, u_char row, const char *string,
+			       const Font *font, u_int fgColorBGR)
+{
+  u_char len = fontFit(font, col, string), i, x, y;
+  for (i = 0; i < len; i++, col += font->width + 1) {
+    const u_char *glyph = fontGlyph(font, string[i]);
+    for (y = 0; y < font->height; y++) {
+      for (x = 0; x < font->width; x++) {
+	u_char start = x;
+	while (x < font->width && fontBit(font, glyph, x, y))
+	  x++;
+	if (x > start)
+	  fillRectangle(col + start, row + y, x - start, 1, fgColorBGR);
+      }
+    }
+  }
+}
+
+/** Draw string in widget, repainting only the cells that changed
+ *
+ *  A cell changes when its character differs from the one shown (or
+ *  nothing is shown there yet).  Cells past the end of string that
+ *  still show a character are blanked.  Each run of adjacent changed
+ *  cells is drawn through one window.
+ */
+void textWidgetDraw(TextWidget *widget, const char *string)
+{
+  const Font *font = widget->font;
+  u_char advance = font->width + 1, cells = 0, i = 0, start, newLen = 0;
+  while (cells < widget->size
+	 && widget->col + advance * cells + font->width - 1 < screenWidth)
+    cells++;			/* cells that fit in widget & on screen */
+  while (newLen < cells && string[newLen])
+    newLen++;
+  while (i < cells) {
+    for (start = i; i < cells; i++) { /* find run of changed cells */
+      char c = i < newLen ? string[i] : ' ';
+      if (i >= newLen && i >= widget->shownLen)
+	break;			/* nothing here, nothing to show */
+      if (i < widget->shownLen && widget->shown[i] == c)
+	break;			/* unchanged */
+      widget->shown[i] = c;
+    }
+    if (start && start >= widget->shownLen && i > start)
+      fillRectangle(widget->col + advance * start - 1, widget->row, /* new gap */
+		    1, font->height, widget->bgColorBGR);
+    drawFontChars(widget->col + advance * start, widget->row,
+		  widget->shown + start, i - start, font,
+		  widget->fgColorBGR, widget->bgColorBGR);
+    if (i >= newLen && i >= widget->shownLen)
+      break;
+    i++;			/* skip unchanged cell */
+  }
+  if (newLen > widget->shownLen)
+    widget->shownLen = newLen;
+}
+
+/** Forget what widget shows (e.g. after the screen is cleared) */
+void textWidgetReset(TextWidget *widget)
+{
+  widget->shownLen = 0;
+}
+
+/** Draw string at col,row in the 5x7 font through one window
  *  Type:
  *  FONT_SM - small (5x8,) FONT_MD - medium (8x12,) FONT_LG - large (11x16)
  *  FONT_SM_BKG, FONT_MD_BKG, FONT_LG_BKG - as above, but with background color
@@ -87,11 +399,7 @@ void drawChar5x7(u_char rcol, u_char rrow, char c,
 void drawString5x7(u_char col, u_char row, char *string,
 		u_int fgColorBGR, u_int bgColorBGR)
 {
-  u_char cols = col;
-  while (*string) {
-    drawChar5x7(cols, row, *string++, fgColorBGR, bgColorBGR);
-    cols += 6;
-  }
+  drawStringFont(col, row, string, &font5x7, fgColorBGR, bgColorBGR);
 }
 
 
@@ -13,6 +13,37 @@
  */
 void drawPixel(u_char col, u_char row, u_int colorBGR);
 
+/** A pixel to be drawn by drawPixels */
+typedef struct {
+  u_char col, row;
+  u_int colorBGR;
+} Pixel;
+
+/** A set of pixels kept in row, then column order
+ *
+ *  \param pixels Storage for up to size pixels
+ *  \param count Pixels in use
+ *  \param size Capacity of pixels
+ */
+typedef struct {
+  Pixel *pixels;
+  u_char count, size;
+} PixelBatch;
+
+/** Add pixel at col,row to batch, keeping it sorted.
+ *  A pixel already in the batch at col,row takes the new color.
+ *
+ *  \return 0 if the batch is full
+ */
+u_char pixelBatchAdd(PixelBatch *batch, u_char col, u_char row, u_int colorBGR);
+
+/** Draw every pixel of batch (which is left unchanged)
+ *
+ *  Horizontally adjacent pixels are written through one window, so
+ *  a run of n pixels costs one window setup rather than n.
+ */
+void drawPixels(const PixelBatch *batch);
+
 /** Fill rectangle
  *
  *  \param colMin Column start
@@ -30,6 +61,11 @@ void fillRectangle(u_char colMin, u_char rowMin, u_char width, u_char height, u_
 void clearScreen(u_int colorBGR);
 
 /** Draw string at col,row
+ *
+ *  The string is drawn through one window, row by row, including the
+ *  1 pixel gap between characters (in the background color).
+ *  Characters that would not fit on the screen are not drawn.
+ *
  *  Type:
  *  FONT_SM - small (5x8,) FONT_MD - medium (8x12,) FONT_LG - large (11x16)
  *  FONT_SM_BKG, FONT_MD_BKG, FONT_LG_BKG - as above, but with background color
@@ -44,6 +80,91 @@ void clearScreen(u_int colorBGR);
 void drawString5x7(u_char col, u_char row, char *string, 
 		   u_int fgColorBGR, u_int bgColorBGR);
 
+/** Draw string at col,row in font
+ *
+ *  Like drawString5x7, for any font: the string is drawn through one
+ *  window, including the 1 pixel gap between characters.
+ *
+ *  \param col Column to start drawing string
+ *  \param row Row to start drawing string
+ *  \param string The string
+ *  \param font The font (e.g. &font8x12)
+ *  \param fgColorBGR Foreground color in BGR
+ *  \param bgColorBGR Background color in BGR
+ */
+void drawStringFont(u_char col, u_char row, const char *string, const Font *font,
+		    u_int fgColorBGR, u_int bgColorBGR);
+
+/** Draw string at col,row in font, magnified: each font pixel becomes
+ *  a scale x scale square (e.g. scale 2 makes font5x7's 5x8 cells 10x16)
+ *
+ *  The string is drawn through one window.  Each row of the string is
+ *  read from the font once and streamed scale times, each bit as a run
+ *  of scale pixels.  Only the characters that fit across the screen
+ *  are drawn, and rows below it are clipped.
+ *
+ *  \param scale Magnification (1 to 8)
+ */
+void drawStringFontScaled(u_char col, u_char row, const char *string,
+			  const Font *font, u_char scale,
+			  u_int fgColorBGR, u_int bgColorBGR);
+
+/** Draw a 1 bit per pixel bitmap at col,row, magnified by scale,
+ *  clipped to the screen
+ *
+ *  \param bits width*height bits, row by row with the first pixel in 
+ *  the MSB (the layout of a FONT_PACKED glyph)
+ *  \param scale Magnification (1 to 8)
+ */
+void drawBitmap(u_char col, u_char row, const u_char *bits, u_char width,
+		u_char height, u_char scale, u_int fgColorBGR, u_int bgColorBGR);
+
+/** Draw string at col,row in font, leaving background pixels unchanged
+ *
+ *  Each horizontal span of set pixels in a glyph row is written
+ *  through its own window.
+ */
+void drawStringFontTransparent(u_char col, u_char row, const char *string,
+			       const Font *font, u_int fgColorBGR);
+
+/** Width in pixels of string drawn in font */
+u_int fontStringWidth(const Font *font, const char *string);
+
+/** Glyph of character c in font (that of firstChar, or a FONT_PACKED
+ *  font's first glyph, if c is not in font)
+ */
+const u_char *fontGlyph(const Font *font, char c);
+
+/** True if pixel x,y (from the glyph's top left) of glyph is set */
+u_char fontBit(const Font *font, const u_char *glyph, u_char x, u_char y);
+
+/** A line of text that is redrawn differentially
+ *
+ *  \param col, row Top left of the first character
+ *  \param font The font
+ *  \param shown Storage for the size characters on screen
+ *  \param size Cells in the widget
+ *  \param shownLen Cells drawn so far (0 to start)
+ */
+typedef struct {
+  u_char col, row;
+  const Font *font;
+  u_int fgColorBGR, bgColorBGR;
+  char *shown;
+  u_char size, shownLen;
+} TextWidget;
+
+/** Draw string in widget, repainting only the character cells
+ *  that differ from what it last drew
+ *
+ *  Runs of adjacent changed cells are written through one window, so
+ *  redrawing an unchanged string sends nothing to the LCD.
+ */
+void textWidgetDraw(TextWidget *widget, const char *string);
+
+/** Make the next textWidgetDraw repaint every cell */
+void textWidgetReset(TextWidget *widget);
+
 /** 5x7 font - this function draws background pixels
  *  Adapted from RobG's EduKit
  */
@@ -10,6 +10,9 @@
  
 #include "lcdutils.h"
 #include "msp430.h"
+#if LCD_ASYNC
+#include "libTimer.h"
+#endif
 
 u_char _orientation = 0;
 
@@ -47,7 +50,9 @@ u_char _orientation = 0;
 #define CASETP							0x2A
 #define PASETP							0x2B
 #define RAMWRP							0x2C
+#define SCRLAR							0x33
 #define	MADCTL							0x36
+#define VSCSAD							0x37
 #define	COLMOD							0x3A
 #define GMCTRP1							0xE0
 #define GMCTRN1							0xE1
@@ -78,6 +83,561 @@ static void setUpSPIforLCD() {
 
 /** Screen dimensions */
 
+typedef union {
+  u_char colorBytes[2];
+  u_int colorBGRWord;
+} ColorBGR;
+
+/** Window tracking
+ *
+ *  The controller keeps the window set by CASET and PASET until they 
+ *  are sent again, and RAMWR data continues at the next address (back
+ *  at the window's start once it is full) until another command is sent.  lcd_setArea therefore only sends the 
+ *  address commands that change, and nothing at all when the new 
+ *  window starts where the pixels written so far stopped.
+ */
+#define AREA_COLS	0x01	/**< send CASET */
+#define AREA_ROWS	0x02	/**< send PASET */
+#define AREA_CURSOR	0x04	/**< (winState) RAMWR in progress at cur */
+
+static u_char winState = 0;	/**< AREA_* bits that are known */
+static u_char winCol0, winCol1, winRow0, winRow1; /**< CASET & PASET */
+static u_char curCol, curRow;	/**< address of next pixel written */
+unsigned long lcd_areaBytesSaved = 0;
+
+/** Forget the window, e.g. after other commands (private) */
+static void
+lcd_forgetWindow()
+{
+  winState = 0;
+}
+
+/** Advance the cursor past pixels written (private) */
+static void
+lcd_advance(u_int pixels)
+{
+  u_char width = winCol1 - winCol0 + 1;
+  u_int rowLeft = winCol1 - curCol + 1;
+  if (!(winState & AREA_CURSOR))
+    return;
+  if (pixels < rowLeft) {
+    curCol += pixels;
+    return;
+  }
+  for (pixels -= rowLeft; ; pixels -= width) {
+    if (curRow++ == winRow1) {	/**< address wraps to window start */
+      curRow = winRow0;
+      if (pixels)		/**< and beyond: not worth tracking */
+	winState &= ~AREA_CURSOR;
+      break;
+    }
+    if (pixels < width)
+      break;
+  }
+  curCol = winCol0 + pixels;
+}
+
+/** Advance the cursor past len bytes of pixel data (private) */
+static void
+lcd_advanceBytes(u_int len)
+{
+  if (len & 1)
+    winState &= ~AREA_CURSOR;	/**< half a pixel written */
+  else
+    lcd_advance(len >> 1);
+}
+
+static void lcd_writeArea(u_char parts, u_char colStart, u_char rowStart,
+			  u_char colEnd, u_char rowEnd);
+
+/** Set area to draw to */
+void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd) 
+{
+  u_char parts = AREA_COLS | AREA_ROWS;
+  if ((winState & AREA_COLS) && winCol0 == colStart && winCol1 == colEnd) {
+    parts &= ~AREA_COLS;
+    if ((winState & AREA_CURSOR) && curCol == colStart && curRow == rowStart
+	&& rowEnd <= winRow1) {	/**< continues previous window */
+      lcd_areaBytesSaved += 11;
+      return;
+    }
+  }
+  if ((winState & AREA_ROWS) && winRow0 == rowStart && winRow1 == rowEnd)
+    parts &= ~AREA_ROWS;
+  lcd_areaBytesSaved += ((parts & AREA_COLS) ? 0 : 5) + ((parts & AREA_ROWS) ? 0 : 5);
+  lcd_writeArea(parts, colStart, rowStart, colEnd, rowEnd);
+  winCol0 = curCol = colStart;
+  winCol1 = colEnd;
+  winRow0 = curRow = rowStart;
+  winRow1 = rowEnd;
+  winState = AREA_COLS | AREA_ROWS | AREA_CURSOR;
+}
+
+#if LCD_ASYNC
+
+/** Interrupt-driven transfers
+ *
+ *  Drawing calls append compact records to lcdQueue.  The USCI_B0 TX
+ *  interrupt expands them into SPI bytes, one byte per interrupt, so
+ *  the CPU only waits when the queue is full.  Records are
+ *
+ *    LCDQ_CMD   command
+ *    LCDQ_DATA  data
+ *    LCDQ_AREA  parts [colStart colEnd] [rowStart rowEnd]
+ *                                            ([CASET] [PASET] RAMWR)
+ *    LCDQ_RUN   colorHi colorLo countLo countHi
+ *    LCDQ_GLYPH char fgHi fgLo bgHi bgLo         (5x7 character cell)
+ *    LCDQ_BUF   pointer lenLo lenHi              (bytes sent from RAM)
+ *    LCDQ_PAD                                    (completes 12 bit pixel)
+ *
+ *  In 12 bit mode (LCD_COLOR_BITS) pixels are packed in pairs into
+ *  three bytes.  The second byte of a pair is only sent once the 
+ *  pair's second pixel is queued, or padded when a command or LCDQ_PAD
+ *  follows.
+ */
+#define LCDQ_CMD	1
+#define LCDQ_DATA	2
+#define LCDQ_AREA	3
+#define LCDQ_RUN	4
+#define LCDQ_GLYPH	5
+#define LCDQ_BUF	6
+#define LCDQ_PAD	7
+
+typedef union {
+  const u_char *ptr;
+  u_char bytes[sizeof(const u_char *)];
+} BufPtr;
+
+#define LCDQ_MASK	(LCD_QUEUE_SIZE - 1)
+
+static u_char lcdQueue[LCD_QUEUE_SIZE];
+static volatile u_char lcdqHead = 0; /**< next slot written (by producer) */
+static volatile u_char lcdqTail = 0; /**< next slot read (by tx interrupt) */
+
+/** State of the record being transmitted (owned by lcd_txPump) */
+static u_char txSeq[12];	/**< command sequence bytes */
+static u_int txSeqData;		/**< bit i set when txSeq[i] is data */
+static u_char txSeqLen = 0, txSeqPos = 0;
+static u_int txPixels = 0;	/**< pixels remaining in run or glyph */
+static u_char txLowNext = 0;	/**< low byte of txColor is next */
+static u_int txColor, txFg, txBg;
+static const u_char *txGlyph = 0; /**< glyph columns, 0 for a run */
+static u_char txGlyphCol, txGlyphBit;
+static const u_char *txBuf;	/**< next byte of caller's buffer */
+static u_int txBufLen = 0;	/**< bytes remaining in txBuf */
+static volatile u_char txBufsPending = 0; /**< buffers not yet sent */
+static u_char txDcHigh = 1;	/**< current state of D/C line */
+#if LCD_COLOR_BITS == 12
+static u_char txPairPos = 0;	/**< bytes of current pixel pair sent */
+static u_char txHold;		/**< rest of the pair's last byte sent */
+#endif
+
+static u_char
+lcdq_used()
+{
+  return (lcdqHead - lcdqTail) & LCDQ_MASK;
+}
+
+static u_char
+lcdq_pop()
+{
+  u_char val = lcdQueue[lcdqTail];
+  lcdqTail = (lcdqTail + 1) & LCDQ_MASK;
+  return val;
+}
+
+static u_int
+lcdq_popWord()
+{
+  u_int hi = lcdq_pop();
+  return (hi << 8) | lcdq_pop();
+}
+
+/** Color of the current glyph pixel (private) */
+static u_int
+tx_glyphColor()
+{
+  return (txGlyph[txGlyphCol] & txGlyphBit) ? txFg : txBg;
+}
+
+/** Append address command and its start & end to txSeq (private) */
+static void
+tx_seqAddress(u_char command)
+{
+  txSeqData |= 0x1e << txSeqLen; /* the four bytes after command */
+  txSeq[txSeqLen++] = command;
+  txSeq[txSeqLen++] = 0;
+  txSeq[txSeqLen++] = lcdq_pop();
+  txSeq[txSeqLen++] = 0;
+  txSeq[txSeqLen++] = lcdq_pop();
+}
+
+/** Pop a color, converted to the format sent (private) */
+static u_int
+lcdq_popColor()
+{
+  u_int color = lcdq_popWord();
+#if LCD_COLOR_BITS == 12
+  color = bgr2c12(color);
+#endif
+  return color;
+}
+
+/** Load the next record from the queue (private)
+ *  \return 0 if the queue is empty
+ */
+static u_char
+tx_load()
+{
+  u_char op, i;
+  if (lcdqTail == lcdqHead)
+    return 0;
+  op = lcdq_pop();
+  txSeqPos = txSeqLen = 0;
+  txSeqData = 0;
+#if LCD_COLOR_BITS == 12
+  if (txPairPos == 1 && (op == LCDQ_CMD || op == LCDQ_AREA || op == LCDQ_PAD)) {
+    txSeqData = 1;		/* pad the pair's odd pixel */
+    txSeq[txSeqLen++] = txHold;
+    txPairPos = 0;
+  }
+#endif
+  switch (op) {
+  case LCDQ_CMD:
+  case LCDQ_DATA:
+    txSeqData |= (u_int)(op == LCDQ_DATA) << txSeqLen;
+    txSeq[txSeqLen++] = lcdq_pop();
+    break;
+  case LCDQ_AREA: {		/* [CASET 0 c0 0 c1] [PASET 0 r0 0 r1] RAMWR */
+    u_char parts = lcdq_pop();
+    if (parts & AREA_COLS)
+      tx_seqAddress(CASETP);
+    if (parts & AREA_ROWS)
+      tx_seqAddress(PASETP);
+    txSeq[txSeqLen++] = RAMWRP;
+    break;
+  }
+  case LCDQ_RUN:
+    txColor = lcdq_popColor();
+    txPixels = lcdq_pop();
+    txPixels |= lcdq_pop() << 8;
+    txGlyph = 0;
+    txLowNext = 0;
+    break;
+  case LCDQ_GLYPH:
+    txGlyph = font_5x7[lcdq_pop() - 0x20];
+    txFg = lcdq_popColor();
+    txBg = lcdq_popColor();
+    txGlyphCol = 0;
+    txGlyphBit = 0x01;
+    txPixels = 5 * 8;
+    txLowNext = 0;
+    break;
+  case LCDQ_BUF: {
+    BufPtr buf;
+    for (i = 0; i < sizeof(buf.bytes); i++)
+      buf.bytes[i] = lcdq_pop();
+    txBuf = buf.ptr;
+    txBufLen = lcdq_pop();
+    txBufLen |= lcdq_pop() << 8;
+    if (!txBufLen)
+      txBufsPending--;
+    break;
+  }
+  }
+  return 1;
+}
+
+#if LCD_COLOR_BITS == 12
+
+/** Next pixel of the current run, glyph or buffer (private)
+ *  \return 0 if there is none
+ */
+static u_char
+tx_pixel(u_int *color)
+{
+  if (txBufLen) {
+    *color = bgr2c12((txBuf[0] << 8) | txBuf[1]);
+    txBuf += 2;
+    txBufLen -= 2;
+    if (!txBufLen)
+      txBufsPending--;		/**< caller may reuse buffer */
+    return 1;
+  }
+  if (!txPixels)
+    return 0;
+  txPixels--;
+  if (!txGlyph) {
+    *color = txColor;
+    return 1;
+  }
+  *color = tx_glyphColor();
+  if (++txGlyphCol == 5) {	/* next row of glyph */
+    txGlyphCol = 0;
+    txGlyphBit <<= 1;
+  }
+  return 1;
+}
+
+/** Produce the next SPI byte (private)
+ *  \return 0 if there is nothing to send
+ */
+static u_char
+tx_next(u_char *byte, u_char *isData)
+{
+  u_int color;
+  for (;;) {
+    if (txSeqPos < txSeqLen) {
+      *isData = (txSeqData >> txSeqPos) & 1;
+      *byte = txSeq[txSeqPos++];
+      return 1;
+    }
+    if (txPairPos == 2) {	/* last byte of pair */
+      *isData = 1;
+      *byte = txHold;
+      txPairPos = 0;
+      return 1;
+    }
+    if (tx_pixel(&color)) {
+      *isData = 1;
+      if (txPairPos == 0) {	/* first pixel's top 8 bits */
+	*byte = color >> 4;
+	txHold = color << 4;
+	txPairPos = 1;
+      } else {			/* its last 4 bits, second's top 4 */
+	*byte = txHold | (color >> 8);
+	txHold = color;
+	txPairPos = 2;
+      }
+      return 1;
+    }
+    if (!tx_load())
+      return 0;
+  }
+}
+
+#else // LCD_COLOR_BITS == 16
+
+/** Produce the next SPI byte (private)
+ *  \return 0 if there is nothing to send
+ */
+static u_char
+tx_next(u_char *byte, u_char *isData)
+{
+  for (;;) {
+    if (txSeqPos < txSeqLen) {
+      *isData = (txSeqData >> txSeqPos) & 1;
+      *byte = txSeq[txSeqPos++];
+      return 1;
+    }
+    if (txBufLen) {
+      *isData = 1;
+      *byte = *txBuf++;
+      if (!--txBufLen)
+	txBufsPending--;	/**< caller may reuse buffer */
+      return 1;
+    }
+    if (txPixels) {
+      *isData = 1;
+      if (!txLowNext) {
+	if (txGlyph)
+	  txColor = tx_glyphColor();
+	*byte = txColor >> 8;
+	txLowNext = 1;
+      } else {
+	*byte = txColor;
+	txLowNext = 0;
+	txPixels--;
+	if (txGlyph && ++txGlyphCol == 5) { /* next row of glyph */
+	  txGlyphCol = 0;
+	  txGlyphBit <<= 1;
+	}
+      }
+      return 1;
+    }
+    if (!tx_load())
+      return 0;
+  }
+}
+
+#endif // LCD_COLOR_BITS
+
+/** Send the next SPI byte, if any (private)
+ *  Called from the tx interrupt, or with interrupts disabled.
+ *  \return 0 if there was nothing to send
+ */
+static u_char
+lcd_txPump()
+{
+  u_char byte, isData;
+  if (!tx_next(&byte, &isData))
+    return 0;
+  if (isData != txDcHigh) {
+    while (UCB0STAT & UCBUSY);	/**< D/C may only change between bytes */
+    if (isData)
+      LCD_DC_HI();
+    else
+      LCD_DC_LO();
+    txDcHigh = isData;
+  }
+  UCB0TXBUF = byte;
+  return 1;
+}
+
+/** USCI_B0 transmit interrupt: send one byte per TX buffer empty */
+void
+__interrupt_vec(USCIAB0TX_VECTOR) lcd_txIsr()
+{
+  if (IFG2 & UCB0TXIFG) {
+    if (!lcd_txPump())
+      IE2 &= ~UCB0TXIE;		/**< idle until something is queued */
+  }
+}
+
+/** True while queued or partially sent records remain (private) */
+static u_char
+lcd_txBusy()
+{
+#if LCD_COLOR_BITS == 12
+  if (txPairPos == 2)
+    return 1;
+#endif
+  return lcdqTail != lcdqHead || txSeqPos < txSeqLen || txPixels || txBufLen;
+}
+
+/** Append record to the queue, waiting for room (private)
+ *
+ *  Records are written with interrupts disabled so that drawing from 
+ *  an interrupt handler cannot interleave with a partial record.
+ *  If interrupts are off while waiting, the queue is drained here.
+ */
+static void
+lcdq_put(const u_char *record, u_char len)
+{
+  for (;;) {
+    int sr = get_sr();
+    and_sr(~GIE);
+    if (LCDQ_MASK - lcdq_used() >= len) {
+      while (len--) {
+	lcdQueue[lcdqHead] = *record++;
+	lcdqHead = (lcdqHead + 1) & LCDQ_MASK;
+      }
+      IE2 |= UCB0TXIE;		/**< tx interrupt drains the queue */
+      if (sr & GIE)
+	or_sr(GIE);
+      return;
+    }
+    if (sr & GIE)
+      or_sr(GIE);		/**< let tx interrupt make room */
+    else {
+      while (!(IFG2 & UCB0TXIFG));
+      lcd_txPump();
+    }
+  }
+}
+
+void lcd_flush()
+{
+#if LCD_COLOR_BITS == 12
+  u_char record[1] = {LCDQ_PAD};
+  lcdq_put(record, 1);		/**< complete an odd pixel */
+  winState &= ~AREA_CURSOR;	/**< stream is no longer aligned */
+#endif
+  while (lcd_txBusy()) {
+    if (!(get_sr() & GIE)) {	/**< no interrupts: drain here */
+      while (!(IFG2 & UCB0TXIFG));
+      lcd_txPump();
+    }
+  }
+  while (UCB0STAT & UCBUSY);	/**< last byte shifted out */
+}
+
+/** Queue data byte for LCD */
+static inline void 
+lcd_writeData(u_char data) 
+{
+  u_char record[2] = {LCDQ_DATA, data};
+  lcdq_put(record, 2);
+}
+
+/** Queue command for LCD (private) */
+void _writeCommand(u_char command) 
+{
+  u_char record[2] = {LCDQ_CMD, command};
+  lcdq_put(record, 2);
+}
+
+void lcd_writeColorRun(u_int colorBGR, u_int count)
+{
+  u_char record[5] = {LCDQ_RUN, colorBGR >> 8, colorBGR, count, count >> 8};
+  if (count)
+    lcdq_put(record, 5);
+  lcd_advance(count);
+}
+
+void lcd_writeColor(u_int colorBGR)
+{
+  lcd_writeColorRun(colorBGR, 1);
+}
+
+void lcd_writeColorSpans(const ColorSpan *spans, u_char numSpans)
+{
+  for (; numSpans; numSpans--, spans++)
+    lcd_writeColorRun(spans->colorBGR, spans->count);
+}
+
+void lcd_writeGlyph5x7(char c, u_int fgColorBGR, u_int bgColorBGR)
+{
+  u_char record[6] = {LCDQ_GLYPH, c, fgColorBGR >> 8, fgColorBGR,
+		      bgColorBGR >> 8, bgColorBGR};
+  lcdq_put(record, 6);
+  lcd_advance(5 * 8);
+}
+
+void lcd_writeBuffer(const u_char *bytes, u_int len)
+{
+  u_char record[1 + sizeof(BufPtr) + 2], i;
+  BufPtr buf = {.ptr = bytes};
+  record[0] = LCDQ_BUF;
+  for (i = 0; i < sizeof(buf.bytes); i++)
+    record[1 + i] = buf.bytes[i];
+  record[1 + i] = len;
+  record[2 + i] = len >> 8;
+  txBufsPending++;		/**< decremented once bytes are sent */
+  lcdq_put(record, sizeof(record));
+  lcd_advanceBytes(len);
+}
+
+void lcd_waitBuffers(u_char pending)
+{
+  while (txBufsPending > pending) {
+    if (!(get_sr() & GIE)) {	/**< no interrupts: drain here */
+      while (!(IFG2 & UCB0TXIFG));
+      lcd_txPump();
+    }
+  }
+}
+
+static void
+lcd_writeArea(u_char parts, u_char colStart, u_char rowStart,
+	      u_char colEnd, u_char rowEnd)
+{
+  u_char record[6], len = 0;
+  record[len++] = LCDQ_AREA;
+  record[len++] = parts;
+  if (parts & AREA_COLS) {
+    record[len++] = colStart;
+    record[len++] = colEnd;
+  }
+  if (parts & AREA_ROWS) {
+    record[len++] = rowStart;
+    record[len++] = rowEnd;
+  }
+  lcdq_put(record, len);
+}
+
+#else // !LCD_ASYNC
+
 /** Write data to LCD */
 static inline void 
 lcd_writeData(u_char data) 
@@ -87,50 +647,263 @@ lcd_writeData(u_char data)
   UCB0TXBUF = data;		/**< send data */
 }
 
-typedef union {
-  u_char colorBytes[2];
-  u_int colorBGRWord;
-} ColorBGR;
+/** Start a stream of data bytes (private)
+ *  The previous byte must be fully shifted out before D/C changes.
+ */
+static inline void
+lcd_beginStream()
+{
+  while (UCB0STAT & UCBUSY);	/**< wait for previous transfer to complete */
+  LCD_DC_HI();			/**< specify sending data */
+}
+
+/** Send data byte within a stream (private)
+ *  Only waits for the TX buffer, so the next byte is queued while the
+ *  current one is still being shifted out.
+ */
+static inline void
+lcd_streamData(u_char data)
+{
+  while (!(IFG2 & UCB0TXIFG));	/**< wait for room in TX buffer */
+  UCB0TXBUF = data;		/**< send data */
+}
+
+#if LCD_COLOR_BITS == 12
+
+static u_char pixHeld = 0;	/**< a pair's first pixel is half sent */
+static u_char pixHold;		/**< its last 4 bits (in the high nibble) */
+
+/** Stream count pixels of one color, packed in pairs (private) */
+static void
+lcd_streamColor(u_int colorBGR, u_int count)
+{
+  u_int color = bgr2c12(colorBGR);
+  u_char first = color >> 4, second = (color << 4) | (color >> 8);
+  if (!count)
+    return;
+  if (pixHeld) {		/* completes pair */
+    lcd_streamData(pixHold | (color >> 8));
+    lcd_streamData(color);
+    pixHeld = 0;
+    count--;
+  }
+  for (; count >= 2; count -= 2) {
+    lcd_streamData(first);
+    lcd_streamData(second);
+    lcd_streamData(color);
+  }
+  if (count) {			/* odd pixel: rest sent with next one */
+    lcd_streamData(first);
+    pixHold = color << 4;
+    pixHeld = 1;
+  }
+}
+
+/** Complete a half-sent pair before a command (private) */
+static void
+lcd_pad()
+{
+  if (pixHeld) {
+    lcd_streamData(pixHold);
+    pixHeld = 0;
+  }
+}
+
+void lcd_writeColor(u_int colorBGR)
+{
+  lcd_beginStream();
+  lcd_streamColor(colorBGR, 1);
+  lcd_advance(1);
+}
+
+void lcd_writeBuffer(const u_char *bytes, u_int len)
+{
+  lcd_beginStream();
+  lcd_advanceBytes(len);
+  for (; len >= 2; len -= 2, bytes += 2)
+    lcd_streamColor((bytes[0] << 8) | bytes[1], 1);
+}
+
+#else // LCD_COLOR_BITS == 16
+
+/** Stream count pixels of one color (private) */
+static inline void
+lcd_streamColor(u_int colorBGR, u_int count)
+{
+  ColorBGR colorU = {.colorBGRWord = colorBGR};
+  u_char hi = colorU.colorBytes[1], lo = colorU.colorBytes[0];
+  while (count--) {
+    lcd_streamData(hi);
+    lcd_streamData(lo);
+  }
+}
+
+#define lcd_pad()
 
 void lcd_writeColor(u_int colorBGR)
 {
   ColorBGR colorU = {.colorBGRWord = colorBGR};
   lcd_writeData(colorU.colorBytes[1]);
   lcd_writeData(colorU.colorBytes[0]);
+  lcd_advance(1);
+}
+
+void lcd_writeBuffer(const u_char *bytes, u_int len)
+{
+  lcd_beginStream();
+  lcd_advanceBytes(len);
+  while (len--)
+    lcd_streamData(*bytes++);
+}
+
+#endif // LCD_COLOR_BITS
+
+void lcd_writeColorRun(u_int colorBGR, u_int count)
+{
+  lcd_beginStream();
+  lcd_streamColor(colorBGR, count);
+  lcd_advance(count);
+}
+
+void lcd_writeColorSpans(const ColorSpan *spans, u_char numSpans)
+{
+  lcd_beginStream();
+  for (; numSpans; numSpans--, spans++) {
+    lcd_streamColor(spans->colorBGR, spans->count);
+    lcd_advance(spans->count);
+  }
+}
+
+void lcd_writeGlyph5x7(char c, u_int fgColorBGR, u_int bgColorBGR)
+{
+  const u_char *glyph = font_5x7[c - 0x20];
+  u_char col, bit;
+  lcd_beginStream();
+  for (bit = 0x01; bit; bit <<= 1)
+    for (col = 0; col < 5; col++)
+      lcd_streamColor((glyph[col] & bit) ? fgColorBGR : bgColorBGR, 1);
+  lcd_advance(5 * 8);
+}
+
+void lcd_waitBuffers(u_char pending)
+{
+  /* buffers are sent before lcd_writeBuffer returns */
 }
 
 /** Write command to LCD (private) */
 void _writeCommand(u_char command) 
 {
+  lcd_pad();			/**< complete an odd pixel first */
   while (UCB0STAT & UCBUSY);	/**< wait for previous transfer to complete */
   LCD_DC_LO();			          /**< specify sending a command */
   UCB0TXBUF = command;		    /**< send command */
 }
 
-/** Long delay (private) */
-void _delay(u_char x10ms) {
-	while (x10ms > 0) {
-		__delay_cycles(160000);
-		x10ms--;
-	}
+void lcd_flush()
+{
+#if LCD_COLOR_BITS == 12
+  if (pixHeld) {
+    lcd_pad();
+    winState &= ~AREA_CURSOR;	/**< stream is no longer aligned */
+  }
+#endif
+  while (UCB0STAT & UCBUSY);	/**< last byte shifted out */
 }
 
-/** Set area to draw to */
-void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd) 
+static void
+lcd_writeArea(u_char parts, u_char colStart, u_char rowStart,
+	      u_char colEnd, u_char rowEnd)
 {
+  if (parts & AREA_COLS) {
 	_writeCommand(CASETP);
 	lcd_writeData(0);
 	lcd_writeData(colStart);
 	lcd_writeData(0);
 	lcd_writeData(colEnd);
+  }
+  if (parts & AREA_ROWS) {
 	_writeCommand(PASETP);
 	lcd_writeData(0);
 	lcd_writeData(rowStart);
 	lcd_writeData(0);
 	lcd_writeData(rowEnd);
+  }
 	_writeCommand(RAMWRP);
 }
 
+#endif // LCD_ASYNC
+
+/** Long delay (private) */
+void _delay(u_char x10ms) {
+	lcd_flush();		/**< commands must reach the LCD first */
+	while (x10ms > 0) {
+		__delay_cycles(160000);
+		x10ms--;
+	}
+}
+
+/** Hardware scrolling
+ *
+ *  SCRLAR splits the panel's long edge (memory lines 0..159) into top,
+ *  scrolling and bottom areas, and VSCSAD selects the memory line shown
+ *  first in the scrolling area.  In ORIENTATION_VERTICAL and 
+ *  ORIENTATION_HORIZONTAL_ROTATED MADCTL mirrors the long edge, so 
+ *  screen position p is memory line LONG_EDGE_PIXELS-1-p.
+ */
+#if (ORIENTATION == ORIENTATION_VERTICAL) || (ORIENTATION == ORIENTATION_HORIZONTAL_ROTATED)
+# define SCROLL_MIRRORED 1
+#else
+# define SCROLL_MIRRORED 0
+#endif
+
+static u_char scrollFirst = 0, scrollCount = 0, scrollOffset = 0;
+
+/** Send command followed by 16 bit parameters (private) */
+static void
+lcd_writeWords(u_char command, const u_int *words, u_char numWords)
+{
+  _writeCommand(command);
+  for (; numWords; numWords--, words++) {
+    lcd_writeData(*words >> 8);
+    lcd_writeData(*words);
+  }
+  lcd_forgetWindow();		/**< RAMWR must be resent */
+}
+
+void lcd_setScrollArea(u_char first, u_char count)
+{
+  u_int areas[3];		/**< TFA, VSA, BFA in memory lines */
+  areas[0] = SCROLL_MIRRORED ? LONG_EDGE_PIXELS - first - count : first;
+  areas[1] = count;
+  areas[2] = LONG_EDGE_PIXELS - areas[0] - count;
+  lcd_writeWords(SCRLAR, areas, 3);
+  scrollFirst = first;
+  scrollCount = count;
+  lcd_scrollTo(0);
+}
+
+void lcd_scrollTo(u_char offset)
+{
+  u_int top = SCROLL_MIRRORED ? LONG_EDGE_PIXELS - scrollFirst - scrollCount
+    : scrollFirst;
+  if (SCROLL_MIRRORED && offset)
+    top += scrollCount - offset;
+  else
+    top += offset;
+  lcd_writeWords(VSCSAD, &top, 1);
+  scrollOffset = offset;
+}
+
+u_char lcd_scrollAddress(u_char pos)
+{
+  u_int addr = pos + scrollOffset;
+  if (pos < scrollFirst || pos >= scrollFirst + scrollCount)
+    return pos;
+  if (addr >= scrollFirst + scrollCount)
+    addr -= scrollCount;
+  return addr;
+}
+
 /** Initialize onboard LCD */
 void lcd_init() 
 {
@@ -139,8 +912,8 @@ void lcd_init()
   _delay(20);
   _writeCommand(SLEEPOUT); /**< exit sleep */
   _delay(20);
-  _writeCommand(COLMOD);   /**< Set Color Format 16bit */
-  lcd_writeData(0x05);
+  _writeCommand(COLMOD);   /**< Set Color Format */
+  lcd_writeData(LCD_COLOR_BITS == 12 ? 0x03 : 0x05);
   _writeCommand(DISPON);   /**< display ON */
 
   _writeCommand(MADCTL);
@@ -157,5 +930,6 @@ void lcd_init()
   default:
     lcd_writeData(0xC8);
   }
+  lcd_forgetWindow();
 }
 
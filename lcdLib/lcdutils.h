@@ -16,6 +16,35 @@ extern const unsigned int font_11x16[95][11];
 
 extern const unsigned int colors[43];
 
+/** Font layout flags */
+#define FONT_COLUMN_MAJOR 0x01	/**< a glyph is a list of columns (else rows) */
+#define FONT_MSB_FIRST    0x02	/**< first pixel is the MSB (else the LSB) */
+#define FONT_WIDE         0x04	/**< columns/rows are u_ints (else u_chars) */
+#define FONT_PACKED       0x08	/**< glyphs are bit strings, chars lists them */
+
+/** Describes a bitmapped font's glyph table
+ *
+ *  Each glyph is width x height pixels, stored as width columns
+ *  (FONT_COLUMN_MAJOR) or height rows of bits.  A FONT_PACKED glyph
+ *  is instead its width*height bits, row by row with the first pixel
+ *  in the MSB, padded to a whole byte; such fonts (see makeFont.c)
+ *  hold only the characters listed in chars, and index gives the
+ *  glyph number of each character from firstChar to lastChar (0, the
+ *  first glyph, for those not in the font).  Without an index, glyphs
+ *  are found by searching chars.
+ */
+typedef struct {
+  const void *glyphs;		/**< glyph of firstChar, then the rest */
+  u_char width, height;		/**< glyph size in pixels */
+  u_char firstChar, numChars;	/**< characters in table */
+  u_char flags;			/**< FONT_* */
+  const char *chars;		/**< FONT_PACKED: character of each glyph */
+  const u_char *index;		/**< FONT_PACKED: glyph of firstChar..lastChar */
+  u_char lastChar;
+} Font;
+
+extern const Font font5x7, font8x12, font11x16;
+
 
 /** Orientation */
 #define LONG_EDGE_PIXELS				160
@@ -38,10 +67,43 @@ extern const unsigned int colors[43];
 # define screenWidth LONG_EDGE_PIXELS
 #endif
 
+/** Transfer mode
+ *
+ *  0: each call polls the SPI port until its bytes are sent.
+ *  1: calls append records to a LCD_QUEUE_SIZE byte queue that the 
+ *     USCI_B0 TX interrupt drains, so drawing overlaps other work.
+ *     Callers wait only while the queue is full (or in lcd_flush).
+ */
+#ifndef LCD_ASYNC
+#define LCD_ASYNC 0
+#endif
+
+/** Bytes of RAM used by the transfer queue (a power of 2) */
+#ifndef LCD_QUEUE_SIZE
+#define LCD_QUEUE_SIZE 32
+#endif
+
+/** Pixel format sent to the LCD
+ *
+ *  16: 5-6-5 bits per pixel (COLMOD 0x05), two bytes per pixel.
+ *  12: 4-4-4 bits per pixel (COLMOD 0x03), two pixels in three bytes.
+ *      Colors are still given in BGR (see bgr2c12) and converted as
+ *      they are sent.  A pixel run that ends halfway through a byte is
+ *      completed by the next command; lcd_flush() completes it too, so
+ *      drawing after lcd_flush must begin with lcd_setArea.
+ */
+#ifndef LCD_COLOR_BITS
+#define LCD_COLOR_BITS 16
+#endif
+
 /** Initialize the onboard LCD */
 void lcd_init();
 
 /** Set area to draw to
+ *
+ *  Address commands are only sent when they differ from the current
+ *  window; if the new area starts where the pixels written so far 
+ *  stopped (e.g. the next row of the same columns), nothing is sent.
  *  
  *  \param colStart Start column of the area
  *  \param rowStart Start row of the area
@@ -50,12 +112,106 @@ void lcd_init();
  */
 void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd);
 
+/** SPI bytes lcd_setArea has not needed to send */
+extern unsigned long lcd_areaBytesSaved;
+
+/** Wait until everything written so far has been sent to the LCD
+ */
+void lcd_flush();
+
+/** Hardware scrolling
+ *
+ *  The controller scrolls along the panel's long edge: screen rows in
+ *  the vertical orientations and screen columns in the horizontal ones
+ *  (LCD_SCROLL_AXIS).  A band of rows (columns) spanning the whole 
+ *  screen width (height) wraps around as it scrolls; pixels outside 
+ *  the band stay put.
+ */
+#if (ORIENTATION == ORIENTATION_VERTICAL) || (ORIENTATION == ORIENTATION_VERTICAL_ROTATED)
+# define LCD_SCROLL_AXIS 1	/**< rows scroll */
+#else
+# define LCD_SCROLL_AXIS 0	/**< columns scroll */
+#endif
+
+/** Define the scrolling band and reset its offset to 0
+ *
+ *  \param first First row (column) of the band
+ *  \param count Rows (columns) in the band
+ */
+void lcd_setScrollArea(u_char first, u_char count);
+
+/** Scroll the band's contents toward its first row (column)
+ *
+ *  \param offset Rows (columns) scrolled, less than the band's count
+ */
+void lcd_scrollTo(u_char offset);
+
+/** Row (column) to draw at so that pixels appear at pos while scrolled
+ *
+ *  \param pos Row (column) on screen
+ */
+u_char lcd_scrollAddress(u_char pos);
+
 /** Write color to LCD
  *
  *  \param colorBGR The color in BGR
  */
 void lcd_writeColor(u_int colorBGR);
 
+/** Write count pixels of the same color to LCD
+ *
+ *  Bytes are streamed back to back without waiting for each transfer
+ *  to complete.
+ *
+ *  \param colorBGR The color in BGR
+ *  \param count Number of pixels
+ */
+void lcd_writeColorRun(u_int colorBGR, u_int count);
+
+/** A run of pixels sharing a color */
+typedef struct {
+  u_int colorBGR;
+  u_char count;
+} ColorSpan;
+
+/** Write a sequence of color runs to LCD as one stream
+ *
+ *  \param spans The runs, in the order their pixels are written
+ *  \param numSpans Number of runs
+ */
+void lcd_writeColorSpans(const ColorSpan *spans, u_char numSpans);
+
+/** Write bytes (e.g. pixels already in LCD byte order) to LCD
+ *
+ *  In 12 bit mode (LCD_COLOR_BITS) the bytes are BGR pixels, high
+ *  byte first, that are converted as they are sent; len must be even.
+ *
+ *  When transfers are queued (LCD_ASYNC) the bytes are read while they
+ *  are sent, so the buffer must not change until lcd_waitBuffers()
+ *  shows it is done.
+ *
+ *  \param bytes The data bytes
+ *  \param len Number of bytes
+ */
+void lcd_writeBuffer(const u_char *bytes, u_int len);
+
+/** Wait until at most pending buffers passed to lcd_writeBuffer have 
+ *  not been completely sent.  Buffers are sent in the order they were 
+ *  written, so lcd_waitBuffers(1) frees all but the most recent.
+ */
+void lcd_waitBuffers(u_char pending);
+
+/** Write a 5x7 character cell (5 columns by 8 rows) to LCD
+ *
+ *  \param c The character
+ *  \param fgColorBGR Foreground color in BGR
+ *  \param bgColorBGR Background color in BGR
+ */
+void lcd_writeGlyph5x7(char c, u_int fgColorBGR, u_int bgColorBGR);
+
+/** BGR color as sent in 12 bit mode (the top 4 bits of each channel) */
+#define bgr2c12(val) ((((val) >> 4) & 0xf00) | (((val) >> 3) & 0xf0) | (((val) >> 1) & 0xf))
+
 #define rgb2bgr(val) ((((val) << 11)&0xf800) | ((val)&0x7e0) | (((val)>>11)&0x1f))
 
 /** Colors */
@@ -0,0 +1,102 @@
+
+///////////////////////////////////////////
+// makeFont: generate a font holding only the characters a program uses
+//
+// usage: makeFont <5x7|8x12|11x16> <name> <characters>
+//   e.g. makeFont 11x16 fontDigits "0123456789"
+//
+// Writes <name>.c, defining the Font <name>, and <name>.h declaring it.
+// Glyphs are stored FONT_PACKED: width*height bits, row by row and
+// first pixel in the MSB, padded to a whole byte, in the order the
+// characters are listed (in <name>.chars).  lcddraw decodes them directly,
+// and finds them through <name>_index: the glyph number of each character
+// from the lowest listed to the highest (so "0123456789" costs 10 bytes).
+///////////////////////////////////////////
+
+#include "stdio.h"
+#include "string.h"
+#include "assert.h"
+#include "lcdutils.h"
+#include "lcddraw.h"
+
+int main(int argc, char **argv)
+{
+  const Font *font = 0;
+  const char *name, *fontName;
+  char chars[256], filename[100];
+  int numChars = 0, i, glyphBytes, x, y, first = 255, last = 0, c;
+  FILE *fp;
+
+  if (argc == 4) {
+    fontName = argv[1];
+    if (!strcmp(fontName, "5x7")) font = &font5x7;
+    if (!strcmp(fontName, "8x12")) font = &font8x12;
+    if (!strcmp(fontName, "11x16")) font = &font11x16;
+  }
+  if (!font) {
+    fprintf(stderr, "usage: %s <5x7|8x12|11x16> <name> <characters>\n", argv[0]);
+    return 1;
+  }
+  name = argv[2];
+  for (i = 0; argv[3][i]; i++)	/* each character once */
+    if (!memchr(chars, argv[3][i], numChars))
+      chars[numChars++] = argv[3][i];
+  assert(numChars > 0 && numChars < 256);
+  for (i = 0; i < numChars; i++) {
+    c = (unsigned char)chars[i];
+    if (c < first) first = c;
+    if (c > last) last = c;
+  }
+  glyphBytes = (font->width * font->height + 7) / 8;
+
+  sprintf(filename, "%s.c", name);
+  fp = fopen(filename, "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeFont from font%s\n", fontName);
+  fprintf(fp, "#include \"lcdutils.h\"\n\n");
+  fprintf(fp, "static const unsigned char %s_glyphs[%d] = {\n", name, numChars * glyphBytes);
+  for (i = 0; i < numChars; i++) {
+    const u_char *glyph = fontGlyph(font, chars[i]);
+    unsigned char byte = 0;
+    int bit = 0;
+    fprintf(fp, "   ");
+    for (y = 0; y < font->height; y++)
+      for (x = 0; x < font->width; x++) {
+	byte = (byte << 1) | fontBit(font, glyph, x, y);
+	if (++bit == 8) {
+	  fprintf(fp, " 0x%02x,", byte);
+	  byte = bit = 0;
+	}
+      }
+    if (bit)			/* pad last byte */
+      fprintf(fp, " 0x%02x,", byte << (8 - bit));
+    fprintf(fp, " // '%c'\n", chars[i]);
+  }
+  fprintf(fp, "};\n\n");
+  fprintf(fp, "static const unsigned char %s_index[%d] = { // glyph of each character from %d\n",
+	  name, last - first + 1, first);
+  for (c = first; c <= last; c++) {
+    char *listed = memchr(chars, c, numChars);
+    fprintf(fp, "%s%d,", (c - first) % 16 ? " " : (c > first ? "\n   " : "   "),
+	    listed ? (int)(listed - chars) : 0);
+  }
+  fprintf(fp, "\n};\n\n");
+  fprintf(fp, "const Font %s = {%s_glyphs, %d, %d, %d, %d, FONT_PACKED, \"",
+	  name, name, font->width, font->height, first, numChars);
+  for (i = 0; i < numChars; i++)
+    fprintf(fp, (chars[i] == '"' || chars[i] == '\\') ? "\\%c" : "%c", chars[i]);
+  fprintf(fp, "\", %s_index, %d};\n", name, last);
+  fclose(fp);
+
+  sprintf(filename, "%s.h", name);
+  fp = fopen(filename, "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeFont from font%s\n", fontName);
+  fprintf(fp, "#ifndef %s_included\n#define %s_included\n\n", name, name);
+  fprintf(fp, "#include \"lcdutils.h\"\n\n");
+  fprintf(fp, "extern const Font %s;\t/* %d characters, %d bytes of glyphs */\n",
+	  name, numChars, numChars * glyphBytes);
+  fprintf(fp, "\n#endif // included\n");
+  fclose(fp);
+  return 0;
+}
@@ -0,0 +1,81 @@
+/** \file numfmt.c
+ *  \brief Number formatting without division.
+ */
+#include "numfmt.h"
+
+/** Add 1 to the 4 digit BCD counter at bcd */
+void bcdIncrement(unsigned int *bcd)
+{
+  unsigned int v = *bcd, unit = 1;	/* unit: 1 in the current digit */
+  unsigned char digit;
+  for (digit = 0; digit < 4; digit++, unit <<= 4) {
+    unsigned int mask = unit * 15, nine = (unit << 3) | unit;
+    if ((v & mask) != nine) {
+      *bcd = v + unit;
+      return;
+    }
+    v &= ~mask;			/* 9 -> 0, carry */
+  }
+  *bcd = v;
+}
+
+/** Subtract 1 from the 4 digit BCD counter at bcd */
+void bcdDecrement(unsigned int *bcd)
+{
+  unsigned int v = *bcd, unit = 1;
+  unsigned char digit;
+  for (digit = 0; digit < 4; digit++, unit <<= 4) {
+    unsigned int mask = unit * 15;
+    if (v & mask) {
+      *bcd = v - unit;
+      return;
+    }
+    v |= (unit << 3) | unit;	/* 0 -> 9, borrow */
+  }
+  *bcd = v;
+}
+
+/** Write the low digits BCD digits of bcd to string, blanking leading zeros */
+void bcdToString(unsigned int bcd, char *string, unsigned char digits)
+{
+  unsigned char i;
+  string[digits] = 0;
+  for (i = digits; i; i--) {	/* least significant digit last */
+    string[i - 1] = '0' + (bcd & 15);
+    bcd >>= 4;
+  }
+  for (i = 0; i < digits - 1 && string[i] == '0'; i++)
+    string[i] = ' ';
+}
+
+/** Shifted powers of ten: the 10000s digit is at most 6 (4 + 2) */
+static const unsigned int decimalSteps[] = {
+  40000, 20000, 10000,
+  8000, 4000, 2000, 1000,
+  800, 400, 200, 100,
+  80, 40, 20, 10,
+  0
+};
+
+/** Write value in decimal to string, return the number of digits */
+unsigned char utoa10(unsigned int value, char *string)
+{
+  const unsigned int *step = decimalSteps;
+  unsigned char weight = 4, digit = 0, len = 0;
+  for (; *step; step++) {
+    if (value >= *step) {
+      value -= *step;
+      digit += weight;
+    }
+    if (weight == 1) {		/* digit complete */
+      if (digit || len)
+	string[len++] = '0' + digit;
+      digit = 0;
+      weight = 8;
+    } else
+      weight >>= 1;
+  }
+  string[len++] = '0' + value;
+  string[len] = 0;
+  return len;
+}
@@ -0,0 +1,42 @@
+/** \file numfmt.h
+ *  \brief Number formatting without division.
+ *
+ *  The msp430g2553 has no divide instruction, so "n % 10" and "n / 10"
+ *  each call a libgcc routine that loops over every bit of n.  These
+ *  functions format numbers using only shifts, compares and subtracts,
+ *  and keep counters (such as a score) in BCD so that showing them
+ *  needs no conversion at all.
+ */
+
+#ifndef numfmt_included
+#define numfmt_included
+
+/** Add 1 to the 4 digit BCD counter at bcd (9999 wraps to 0) */
+void bcdIncrement(unsigned int *bcd);
+
+/** Subtract 1 from the 4 digit BCD counter at bcd (0 wraps to 9999) */
+void bcdDecrement(unsigned int *bcd);
+
+/** Write the low digits BCD digits of bcd (most significant first)
+ *  and a terminating 0 to string.  Leading zeros are written as
+ *  blanks so that numbers are right aligned; the last digit is
+ *  always shown.
+ *
+ *  \param bcd Value, 4 bits per decimal digit
+ *  \param string Storage for digits + 1 characters
+ *  \param digits Number of digits to write (1 to 4)
+ */
+void bcdToString(unsigned int bcd, char *string, unsigned char digits);
+
+/** Write value (0 to 65535) in decimal and a terminating 0 to string
+ *
+ *  Each digit is found with four compare/subtracts of a shifted
+ *  power of ten (e.g. 800, 400, 200, 100), so no divide is needed.
+ *
+ *  \param value Value to format
+ *  \param string Storage for up to 6 characters
+ *  \return Number of digits written
+ */
+unsigned char utoa10(unsigned int value, char *string);
+
+#endif // included
@@ -0,0 +1,106 @@
+/** \file kirbybench.c
+ *  \brief Host benchmark: probes to draw the demo scene with Kirby's body
+ *  as three circle layers and as the sprite baked by kirbyBake.
+ *
+ *  Both versions of shapemotion's scene (at its initial positions) are
+ *  drawn by layerDraw into lcdLib's controller stand-in and must show
+ *  the same pixels.  Every check and span call made through a layer's
+ *  AbShape (one per layer probed for a run) is counted, for the whole
+ *  screen and for a frame in which Kirby jumps (his body's bounds and
+ *  the row he moves into are repainted).
+ */
+#include <stdio.h>
+#include "shape.h"
+#include "abCircle.h"
+#include "abEllipse.h"
+#include "kirby.h"
+#include "st7735.h"
+#include "countedShape.h"
+
+#define KirbyCenterWidth screenWidth/2
+#define KirbyCenterHeight screenHeight/2
+
+AbRectOutline fieldOutline = {abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineSpan,
+			      {screenWidth/2-10, screenHeight/2-10}};
+AbRect rectGrass = {abRectGetBounds, abRectCheck, abRectSpan, {200, 10}};
+AbRect rectGround = {abRectGetBounds, abRectCheck, abRectSpan, {200, 40}};
+
+CountedShape cField = COUNTED(fieldOutline), cGrass = COUNTED(rectGrass),
+  cGround = COUNTED(rectGround), cApple = COUNTED(circle5), cFoot = COUNTED(ellipse7x5),
+  cBody = COUNTED(circle14), cSclera = COUNTED(circle4), cPupil = COUNTED(circle2),
+  cKirby = COUNTED(kirby);
+
+u_int bgColor = COLOR_GRAY;
+
+/* shapemotion's scene: field, right foot, Kirby, left foot, grass, ground, apple */
+Layer apple = {(AbShape *)&cApple, {screenWidth+50, 10}, {0,0}, {0,0}, COLOR_RED, 0};
+Layer ground = {(AbShape *)&cGround, {screenWidth, screenHeight}, {0,0}, {0,0}, COLOR_CHOCOLATE, &apple};
+Layer grass = {(AbShape *)&cGrass, {screenWidth, screenHeight-50}, {0,0}, {0,0}, COLOR_GREEN, &ground};
+Layer leftFoot = {(AbShape *)&cFoot, {KirbyCenterWidth-50, KirbyCenterHeight+10}, {0,0}, {0,0},
+		  COLOR_MAGENTA, &grass};
+
+Layer body = {(AbShape *)&cBody, {KirbyCenterWidth-40, KirbyCenterHeight}, {0,0}, {0,0},
+	      COLOR_PINK, &leftFoot};
+Layer sclera = {(AbShape *)&cSclera, {KirbyCenterWidth-32, KirbyCenterHeight-8}, {0,0}, {0,0},
+		COLOR_BLACK, &body};
+Layer pupil = {(AbShape *)&cPupil, {KirbyCenterWidth-32, KirbyCenterHeight-10}, {0,0}, {0,0},
+	       COLOR_WHITE, &sclera};
+Layer rightFoot = {(AbShape *)&cFoot, {KirbyCenterWidth-30, KirbyCenterHeight+10}, {0,0}, {0,0},
+		   COLOR_MAGENTA, &pupil};
+Layer field = {(AbShape *)&cField, {screenWidth/2, screenHeight/2}, {0,0}, {0,0},
+	       COLOR_GRAY, &rightFoot};
+
+Layer bakedKirby = {(AbShape *)&cKirby, {KirbyCenterWidth-40, KirbyCenterHeight}, {0,0}, {0,0},
+		    COLOR_PINK, &leftFoot};
+Layer bakedRightFoot = {(AbShape *)&cFoot, {KirbyCenterWidth-30, KirbyCenterHeight+10}, {0,0}, {0,0},
+			COLOR_MAGENTA, &bakedKirby};
+Layer bakedField = {(AbShape *)&cField, {screenWidth/2, screenHeight/2}, {0,0}, {0,0},
+		    COLOR_GRAY, &bakedRightFoot};
+
+static u_int shown[screenHeight][screenWidth];
+
+// probes to draw area of layers; copies what is shown if save, else compares
+static unsigned long
+draw(Layer *layers, const Region *area, int save)
+{
+  int col, row;
+  layerInit(layers);
+  countedProbes = 0;
+  layerDrawRegion(layers, area);
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++) {
+      if (save)
+	shown[row][col] = st7735_pixel(col, row);
+      else if (shown[row][col] != st7735_pixel(col, row)) {
+	printf("pixel %d,%d is %04x with the baked sprite, %04x with circles\n",
+	       col, row, st7735_pixel(col, row), shown[row][col]);
+	return 0;
+      }
+    }
+  return countedProbes;
+}
+
+int
+main()
+{
+  Region screen = {{0, 0}, {screenWidth-1, screenHeight-1}}, jump;
+  unsigned long circles, baked, circlesJump, bakedJump;
+  usci_sink = st7735_byte;
+  lcd_init();
+  if (!(circles = draw(&field, &screen, 1)) || !(baked = draw(&bakedField, &screen, 0)))
+    return 1;
+  abShapeGetBounds((AbShape *)&kirby, &bakedKirby.pos, &jump);
+  jump.topLeft.axes[1]--;	/* moved up a row */
+  circlesJump = draw(&field, &jump, 0);
+  bakedJump = draw(&bakedField, &jump, 0);
+  if (!circlesJump || !bakedJump)
+    return 1;
+  printf("%-16s %10s %10s\n", "probes", "circles", "baked");
+  printf("%-16s %10lu %10lu (%lu%% fewer)\n", "whole screen", circles, baked,
+	 100 * (circles - baked) / circles);
+  printf("%-16s %10lu %10lu (%lu%% fewer)\n", "jump frame", circlesJump, bakedJump,
+	 100 * (circlesJump - bakedJump) / circlesJump);
+  return 0;
+}
@@ -0,0 +1,123 @@
+/** \file kirbyBake.c
+ *  \brief Build-time bake of Kirby's body into a single AbSprite.
+ *
+ *  Kirby's body, sclera and pupil always move together, yet as three
+ *  circle layers the compositor probes each of them for every run in
+ *  the body's bounds.  This host program draws the three with
+ *  shapeLib's layerDrawRegion into lcdLib's controller stand-in, over
+ *  a background of a key color they don't use, and writes what the
+ *  panel shows to kirby.ppm.  It prints the key (as RRGGBB) for
+ *  makeSprite, which makes it transparent:
+ *
+ *      ./makeSprite kirby kirby.ppm `./kirbyBake`
+ *
+ *  The sprite is centered on the body's center, so shapemotion draws
+ *  it at the body's position.  The feet move on their own and remain
+ *  separate layers.
+ */
+#include <stdio.h>
+#include "shape.h"
+#include "abCircle.h"
+#include "st7735.h"
+
+#define BAKE_COL (screenWidth/2)	/**< body's center while baking */
+#define BAKE_ROW (screenHeight/2)
+
+u_int bgColor = COLOR_GRAY;	/**< replaced by the key while baking */
+
+/* The group, highest layer first: positions are relative to the body's
+   as in shapemotion.c before the bake */
+Layer kirbyBody = {		/**< KIRBY'S BODY LAYER */
+  (AbShape *)&circle14,
+  {BAKE_COL, BAKE_ROW},
+  {0,0}, {0,0},
+  COLOR_PINK,
+  0,
+};
+
+Layer kirbySclera = {		/**< KIRBY'S SCLERA */
+  (AbShape *)&circle4,
+  {BAKE_COL+8, BAKE_ROW-8},
+  {0,0}, {0,0},
+  COLOR_BLACK,
+  &kirbyBody,
+};
+
+Layer kirbyPupil = {		/**< KIRBY'S PUPIL */
+  (AbShape *)&circle2,
+  {BAKE_COL+8, BAKE_ROW-10},
+  {0,0}, {0,0},
+  COLOR_WHITE,
+  &kirbySclera,
+};
+
+/** The group's bounds, widened to be symmetric about the body's center
+ *  (where the sprite is centered)
+ */
+void
+kirbyBakeArea(Region *area)
+{
+  Layer *l;
+  int halfCols = 0, halfRows = 0;
+  for (l = &kirbyPupil; l; l = l->next) {
+    Region bounds;
+    abShapeGetBounds(l->abShape, &l->pos, &bounds);
+    if (BAKE_COL - bounds.topLeft.axes[0] > halfCols) halfCols = BAKE_COL - bounds.topLeft.axes[0];
+    if (bounds.botRight.axes[0] - BAKE_COL > halfCols) halfCols = bounds.botRight.axes[0] - BAKE_COL;
+    if (BAKE_ROW - bounds.topLeft.axes[1] > halfRows) halfRows = BAKE_ROW - bounds.topLeft.axes[1];
+    if (bounds.botRight.axes[1] - BAKE_ROW > halfRows) halfRows = bounds.botRight.axes[1] - BAKE_ROW;
+  }
+  area->topLeft.axes[0] = BAKE_COL - halfCols;
+  area->topLeft.axes[1] = BAKE_ROW - halfRows;
+  area->botRight.axes[0] = BAKE_COL + halfCols;
+  area->botRight.axes[1] = BAKE_ROW + halfRows;
+}
+
+/** 8 bit component of a 5 or 6 bit one (makeSprite's conversion undoes it) */
+static int
+expand(int v, int bits)
+{
+  return (v << (8 - bits)) | (v >> (2 * bits - 8));
+}
+
+int
+main()
+{
+  Region area;
+  Layer *l;
+  u_int key;
+  int col, row;
+  FILE *fp;
+
+  for (key = 1; ; key++) {	/* a background color the group doesn't use */
+    for (l = &kirbyPupil; l && l->color != key; l = l->next)
+      ;
+    if (!l)
+      break;
+  }
+  bgColor = key;
+  usci_sink = st7735_byte;
+  lcd_init();
+  kirbyBakeArea(&area);
+  layerInit(&kirbyPupil);
+  layerDrawRegion(&kirbyPupil, &area);
+  lcd_flush();
+  usci_drain();
+
+  fp = fopen("kirby.ppm", "wb");
+  if (!fp)
+    return 1;
+  fprintf(fp, "P6\n# Kirby's body, sclera and pupil, baked by kirbyBake\n%d %d\n255\n",
+	  area.botRight.axes[0] - area.topLeft.axes[0] + 1,
+	  area.botRight.axes[1] - area.topLeft.axes[1] + 1);
+  for (row = area.topLeft.axes[1]; row <= area.botRight.axes[1]; row++)
+    for (col = area.topLeft.axes[0]; col <= area.botRight.axes[0]; col++) {
+      u_int c = st7735_pixel(col, row);	/* BGR565 */
+      fprintf(fp, "%c%c%c", expand(c & 0x1f, 5), expand((c >> 5) & 0x3f, 6),
+	      expand(c >> 11, 5));
+    }
+  fclose(fp);
+  printf("%02x%02x%02x\n", expand(key & 0x1f, 5), expand((key >> 5) & 0x3f, 6),
+	 expand(key >> 11, 5));
+  return 0;
+}
@@ -10,9 +10,12 @@
 #include <libTimer.h>
 #include <lcdutils.h>
 #include <lcddraw.h>
+#include <numfmt.h>
 #include <p2switches.h>
 #include <shape.h>
 #include <abCircle.h>
+#include <abEllipse.h>
+#include "kirby.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -29,22 +32,19 @@
 #define KirbyCenterHeight screenHeight/2
 
 //AbApple apple5 = {AppleBound, AppleCheck, AppleBody, AppleLeg, AppleLeg};
-AbRect rect10 = {abRectGetBounds, abRectCheck, {10,10}}; /**< 10x10 rectangle */
-AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, 30};
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, {10,10}}; /**< 10x10 rectangle */
+const AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, abRArrowSpan, 30};
 
-AbRectOutline fieldOutline = {	/* playing field */
-  abRectOutlineGetBounds, abRectOutlineCheck,   
+const AbRectOutline fieldOutline = {	/* playing field */
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineSpan,
   {screenWidth/2-10, screenHeight/2-10}
 };
 
-AbRect rectGrass = {abRectGetBounds, abRectCheck, {200, 10}};; /**< 10x10 rectangle */
-AbRect rectGround = {abRectGetBounds, abRectCheck, {200, 40}};; /**< 10x10 rectangle */
+const AbRect rectGrass = {abRectGetBounds, abRectCheck, abRectSpan, {200, 10}};; /**< 10x10 rectangle */
+const AbRect rectGround = {abRectGetBounds, abRectCheck, abRectSpan, {200, 40}};; /**< 10x10 rectangle */
 
 u_int bgColor = COLOR_GRAY;
 
-Layer apple2;
-Layer mapple2;
-
 /*
 Layer brickwall = {
   (AbShape *) &rightArrow,
@@ -99,7 +99,7 @@ Layer layer5 = {		/**< GRASS LAYER */
 
 
 Layer layer4 = {		/**< KIRBY'S LEFT FOOT LAYER */
-  (AbShape *)&circle6,
+  (AbShape *)&ellipse7x5,
   {KirbyCenterWidth-50, KirbyCenterHeight+10}, /**< bit below & right of center */
   {0,0}, {0,0},				    /* next & last pos */
   COLOR_MAGENTA,
@@ -109,40 +109,24 @@ Layer layer4 = {		/**< KIRBY'S LEFT FOOT LAYER */
 
 
 
-Layer layer3 = {		/**< KIRBY'S BODY LAYER */
-  (AbShape *)&circle14,
-  {KirbyCenterWidth-40, KirbyCenterHeight}, /**< center */
+Layer layer3 = {		/**< KIRBY: BODY AND EYES, BAKED (kirbyBake.c) */
+  (AbShape *)&kirby,
+  {KirbyCenterWidth-40, KirbyCenterHeight}, /**< body's center */
   {0,0}, {0,0},				    /* next & last pos */
-  COLOR_PINK,
+  COLOR_PINK,				    /* (sprite has its own colors) */
   &layer4,
 };
 
-Layer layer2 = {		/**< KIRBY'S SCLERA */
-  (AbShape *)&circle4,
-  {KirbyCenterWidth-32, KirbyCenterHeight-8}, /**< center */
-  {0,0}, {0,0},				    /* next & last pos */
-  COLOR_BLACK,
-  &layer3,
-};
-
-Layer layer1 = {		/**< KIRBY'S PUPIL */
-  (AbShape *)&circle2,
-  {KirbyCenterWidth-32, KirbyCenterHeight-10}, /**< center */
-  {0,0}, {0,0},				    /* next & last pos */
-  COLOR_WHITE,
-  &layer2,
-};
-
 Layer layer0 = {		/**< KIRBY'S RIGHT FOOT LAYER */
-  (AbShape *)&circle6,
+  (AbShape *)&ellipse7x5,
   {(KirbyCenterWidth)-30, (KirbyCenterHeight)+10}, /**< bit below & right of center */
   {0,0}, {0,0},				    /* next & last pos */
   COLOR_MAGENTA,
-  &layer1,
+  &layer3,
 };
 
 
-Layer fieldLayer = {		/* playing field as a layer */
+const Layer fieldLayer = {		/* playing field as a layer */
   (AbShape *) &fieldOutline,
   {screenWidth/2, screenHeight/2},/**< center */
   {0,0}, {0,0},				    /* last & next pos */
@@ -173,9 +157,7 @@ typedef struct MovLayer_s {
 MovLayer ml4 = { &layer4, {1,0}, 0 }; //feet moving side to side
 MovLayer ml0 = { &layer0, {1,0}, &ml4 };
 
-MovLayer ml1 = { &layer1, {0,-1}, 0}; /**< Body and eyes only move up and down*/
-MovLayer ml2 = { &layer2, {0,-1}, &ml1 };
-MovLayer ml3 = { &layer3, {0,-1}, &ml2 }; 
+MovLayer ml3 = { &layer3, {0,-1}, 0 }; /**< Body and eyes only move up and down*/
 
 //MovLayer mwall = { &brickwall, {-1,0}, 0 };
 MovLayer mapple = { &apple, {-3,0}, 0 };
@@ -189,9 +171,12 @@ MovLayer mapple = { &apple, {-3,0}, 0 };
 
 
 
-void movLayerDraw(MovLayer *movLayers, Layer *layers)
+/** Moves each layer in movLayers to its next position and records
+ *  the area it vacated and now occupies as damaged.  The damage is 
+ *  repainted, once for the whole frame, by dirtyFlush.
+ */
+void movLayerDraw(MovLayer *movLayers)
 {
-  int row, col;
   MovLayer *movLayer;
 
   and_sr(~8);			/**< disable interrupts (GIE off) */
@@ -204,32 +189,14 @@ void movLayerDraw(MovLayer *movLayers, Layer *layers)
 
 
   for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Region bounds;
-    layerGetBounds(movLayer->layer, &bounds);
-    lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-    for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-      for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-	Vec2 pixelPos = {col, row};
-	u_int color = bgColor;
-	Layer *probeLayer;
-	for (probeLayer = layers; probeLayer; 
-	     probeLayer = probeLayer->next) { /* probe all layers, in order */
-	  if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	    color = probeLayer->color;
-	    break; 
-	  } /* if probe check */
-	} // for checking all layers at col, row
-	lcd_writeColor(color); 
-      } // for col
-    } // for row
-  } // for moving layer being updated
+    dirtyAddLayer(movLayer->layer); /**< old & new positions need repainting */
+  }
 }	  
 
 
 
-Region kirbyfence = {{KirbyCenterWidth-56, 1}, {KirbyCenterWidth-24, 94}};
-Region fence = {{-10,-10}, {screenWidth+30, screenHeight+30}}; /**< Create a fence region */
+const Region kirbyfence = {{KirbyCenterWidth-56, 1}, {KirbyCenterWidth-24, 94}};
+const Region fence = {{-10,-10}, {screenWidth+30, screenHeight+30}}; /**< Create a fence region */
 
 
 
@@ -238,7 +205,7 @@ Region fence = {{-10,-10}, {screenWidth+30, screenHeight+30}}; /**< Create a fen
  *  \param ml The moving shape to be advanced
  *  \param fence The region which will serve as a boundary for ml
  */
-void mlAdvance(MovLayer *ml, Region *fence)
+void mlAdvance(MovLayer *ml, const Region *fence)
 {
   Vec2 newPos;
   u_char axis;
@@ -258,7 +225,7 @@ void mlAdvance(MovLayer *ml, Region *fence)
 }
 
 
-void HorizontalAdvance(MovLayer *ml, Region *fence)
+void HorizontalAdvance(MovLayer *ml, const Region *fence)
 {
   Vec2 newPos;
   Region shapeBoundary;
@@ -276,7 +243,7 @@ void HorizontalAdvance(MovLayer *ml, Region *fence)
 
 
 
-void VerticalAdvance(MovLayer *ml, Region *fence)
+void VerticalAdvance(MovLayer *ml, const Region *fence)
 {
   Vec2 newPos;
   Region shapeBoundary;
@@ -292,7 +259,7 @@ void VerticalAdvance(MovLayer *ml, Region *fence)
   } /**< for ml */
 }
 
-int BodyJump(MovLayer *ml, Region *fence){
+int BodyJump(MovLayer *ml, const Region *fence){
   Vec2 newPos;
   Region shapeBoundary;
   int velocity =  ml->velocity.axes[1];
@@ -326,7 +293,7 @@ void FeetJump(MovLayer *ml, int Bodyvelocity){
   } 
 }
 */
-int Gravity(MovLayer *ml, Region *fence){
+int Gravity(MovLayer *ml, const Region *fence){
   Vec2 newPos;
   Region shapeBoundary;
   int velocity =  ml->velocity.axes[1];
@@ -366,7 +333,11 @@ void buzzer_init(){
 }
 
 
-void buzzer_set_period(short cycles)
+/** Buzzer tones, in timer A cycles of the active clock profile */
+#define TONE_APPLE TONE_PERIOD(25000) /**< apple eaten */
+#define TONE_MISS  TONE_PERIOD(50000) /**< apple missed */
+
+void buzzer_set_period(unsigned int cycles)
 {
   CCR0 = cycles; 
   CCR1 = cycles >> 1;		/* one half cycle */
@@ -375,6 +346,7 @@ void buzzer_set_period(short cycles)
 
 
 int redrawScreen = 1;           /**< Boolean for whether screen needs to be redrawn */
+static u_char gameOver = 0;	/**< set by the WDT handler, drawn by main */
 
 Region fieldFence;		/**< fence around playing field  */
 
@@ -383,7 +355,11 @@ Region fieldFence;		/**< fence around playing field  */
  *  and handles the rendering for the screen
  */
 static char str[5];
+static char scoreShown[4];	/**< score as drawn: only changed digits are redrawn */
+static TextWidget scoreText = {screenWidth/2, screenHeight-20, &font5x7,
+			       COLOR_BLACK, COLOR_WHITE, scoreShown, 4, 0};
 static int pts = 0;
+static unsigned int score = 0;	/**< pts in BCD: shown without dividing */
 void main()
 {
   P1DIR |= GREEN_LED;		/**< Green led on when CPU on */		
@@ -411,11 +387,8 @@ void main()
   char points[8] = {'P', 'o', 'i', 'n', 't', 's', ':'};
   points[7] = 0;
   drawString5x7(screenWidth/2-50, screenHeight-20, points, COLOR_BLACK, COLOR_WHITE);
-  for (int i = 0; i < 4; i++)
-        str[i] = ' ';
-  str[3] = 0 + '0';
-  str[4] = 0;
-  drawString5x7(screenWidth/2, screenHeight-20, str, COLOR_BLACK, COLOR_WHITE);
+  bcdToString(score, str, 4);
+  textWidgetDraw(&scoreText, str);
 
   for(;;) { 
     while (!redrawScreen) { /**< Pause CPU if screen doesn't need updating */
@@ -424,23 +397,21 @@ void main()
     }
     P1OUT |= GREEN_LED;       /**< Green led on when CPU on */
     redrawScreen = 0;
-    //u_int switches = p2sw_read(), i;
-    int c = 3;
-    int temp = pts;
-    while(temp > 0){
-      if(c < 0){
-	break;
-      }
-      int digit = temp % 10;
-      str[c] = digit + '0';
-      temp /= 10;
-      c -= 1;
+    if (gameOver) {		/**< drawn here: interrupts stack on main's stack */
+      static const char gameover[] = "GAME OVER";
+      drawStringFontScaled((screenWidth - 2*fontStringWidth(&font5x7, gameover)) / 2,
+			   screenHeight/2-15, gameover, &font5x7, 2, /* 10x16 glyphs */
+			   COLOR_RED, COLOR_BLACK);
+      continue;
     }
-    drawString5x7(screenWidth/2, screenHeight-20, str, COLOR_BLACK, COLOR_WHITE);    
-    movLayerDraw(&ml0, &layer0);
-    movLayerDraw(&ml3, &layer1);
-    movLayerDraw(&mapple, &apple);
-    //movLayerDraw(&mwall, &wall);
+    //u_int switches = p2sw_read(), i;
+    bcdToString(score, str, 4);
+    textWidgetDraw(&scoreText, str);
+    movLayerDraw(&ml0);
+    movLayerDraw(&ml3);
+    movLayerDraw(&mapple);
+    //movLayerDraw(&mwall);
+    dirtyFlush(&layer0);	/**< repaint the frame's damage from every layer */
   }
 }
 static int obsCount = 0;
@@ -451,6 +422,8 @@ static int max = (screenHeight/2)+10;
 void wdt_c_handler(){
   //InterruptGame();
   static short count = 0;
+  if (!wdtTick())
+    return;			/**< keep the tick rate of the 2 MHz SMCLK */
   
   
   int applehit = 0;
@@ -474,7 +447,7 @@ void wdt_c_handler(){
     if (btn[1] == '2'){ 
       ml3.velocity.axes[1] = -1;
       if(bool1 & !applehit){
-	buzzer_set_period(80);
+	buzzer_set_period(TONE_APPLE);
 	
         int currentpos = mapple.layer -> pos.axes[1];
         int randpos = (currentpos + (obsCount)) % max;
@@ -483,15 +456,7 @@ void wdt_c_handler(){
         //pts += 1;
 	pts = addPts(pts);
 	applehit = 1;
-        int c = 3;
-        int temp = pts;
-        while(temp > 0){
-	  if(c < 0){break;}
-	  int digit = temp % 10;
-	  str[c] = digit + '0';
-	  temp /= 10;
-	  c -= 1;
-        }
+	bcdIncrement(&score);
 	buzzer_set_period(0);
       }
       int v;
@@ -513,22 +478,14 @@ void wdt_c_handler(){
       //int max = (screenHeight/2);
       int currentpos = mapple.layer -> pos.axes[1];
       int randpos = (currentpos + (obsCount)) % max;
-      buzzer_set_period(80);
+      buzzer_set_period(TONE_APPLE);
       mapple.layer -> posNext.axes[0] = screenWidth+50;
       mapple.layer -> posNext.axes[1] = randpos;
       
       //pts += 1;
       pts = addPts(pts);
       applehit = 1;
-      int c = 3;
-      int temp = pts;
-      while(temp > 0){
-	if(c < 0){break;}
-	int digit = temp % 10;
-	str[c] = digit + '0';
-	temp /= 10;
-	c -= 1;
-      }
+      bcdIncrement(&score);
       buzzer_set_period(0);
     }
 
@@ -537,19 +494,12 @@ void wdt_c_handler(){
       //int max = (screenHeight/2);
       int currentpos = mapple.layer -> pos.axes[1];
       int randpos = (currentpos + (obsCount)) % max;
-      buzzer_set_period(40);
+      buzzer_set_period(TONE_MISS);
       mapple.layer -> posNext.axes[0] = screenWidth+50;
       mapple.layer -> posNext.axes[1] = randpos;
       pts -= 1;
-      int c = 3;
-      int temp = pts;
-      while(temp > 0){
-	if(c < 0){break;}
-	int digit = temp % 10;
-	str[c] = digit + '0';
-	temp /= 10;
-	c -= 1;
-      }
+      if (pts >= 0)
+	bcdDecrement(&score);
       buzzer_set_period(0);
     }
  
@@ -562,9 +512,8 @@ void wdt_c_handler(){
 
 
     if(pts < 0){
-      char gameover[12] = {'G', 'A', 'M', 'E', ' ', 'O', 'V', 'E', 'R', ' '};
-      gameover[11] = 0;
-      drawString5x7(screenWidth/2-15, screenHeight/2-15, gameover, COLOR_RED, COLOR_BLACK);
+      gameOver = 1;
+      redrawScreen = 1;
       return;
     }
 
@@ -0,0 +1,110 @@
+#include "shape.h"
+
+/** Damage collected since the last dirtyFlush.
+ *  Regions are kept clipped to the screen and pairwise disjoint.
+ */
+static Region dirtyRegions[DIRTY_MAX_REGIONS];
+static u_char dirtyCount = 0;
+
+// true if r contains no pixels
+static int
+regionEmpty(const Region *r)
+{
+  return (r->topLeft.axes[0] > r->botRight.axes[0] ||
+	  r->topLeft.axes[1] > r->botRight.axes[1]);
+}
+
+// true if r1 and r2 share at least one pixel
+static int
+regionIntersects(const Region *r1, const Region *r2)
+{
+  u_char axis;
+  for (axis = 0; axis < 2; axis ++) {
+    if (r1->topLeft.axes[axis] > r2->botRight.axes[axis] ||
+	r2->topLeft.axes[axis] > r1->botRight.axes[axis])
+      return 0;
+  }
+  return 1;
+}
+
+// cost of repainting r: its pixels plus the window setup
+static u_int
+dirtyCost(const Region *r)
+{
+  u_int width = r->botRight.axes[0] - r->topLeft.axes[0] + 1;
+  u_int height = r->botRight.axes[1] - r->topLeft.axes[1] + 1;
+  return width * height + DIRTY_SETUP_COST;
+}
+
+// extra cost of painting union(r1, r2) rather than r1 and r2 separately
+static int
+dirtyMergePenalty(const Region *r1, const Region *r2)
+{
+  Region rUnion;
+  regionUnion(&rUnion, r1, r2);
+  return (int)(dirtyCost(&rUnion) - dirtyCost(r1) - dirtyCost(r2));
+}
+
+void
+dirtyAdd(const Region *damage)
+{
+  Region r = *damage;
+  u_char i;
+
+  regionClipScreen(&r);
+  if (regionEmpty(&r))
+    return;
+
+  for (;;) {
+    /* absorb regions that overlap r or are cheaper to paint with it */
+    for (i = 0; i < dirtyCount; ) {
+      if (regionIntersects(&r, &dirtyRegions[i]) ||
+	  dirtyMergePenalty(&r, &dirtyRegions[i]) <= 0) {
+	regionUnion(&r, &r, &dirtyRegions[i]);
+	dirtyRegions[i] = dirtyRegions[--dirtyCount];
+	i = 0;			/* grown r may now reach earlier regions */
+      } else
+	i++;
+    }
+    if (dirtyCount < DIRTY_MAX_REGIONS)
+      break;
+    /* full: fold r into the region where that costs least, then rescan */
+    u_char best = 0;
+    int bestPenalty = dirtyMergePenalty(&r, &dirtyRegions[0]);
+    for (i = 1; i < dirtyCount; i++) {
+      int penalty = dirtyMergePenalty(&r, &dirtyRegions[i]);
+      if (penalty < bestPenalty) {
+	best = i;
+	bestPenalty = penalty;
+      }
+    }
+    regionUnion(&r, &r, &dirtyRegions[best]);
+    dirtyRegions[best] = dirtyRegions[--dirtyCount];
+  }
+  dirtyRegions[dirtyCount++] = r;
+}
+
+void
+dirtyAddLayer(const Layer *l)
+{
+  Region bounds;
+  layerGetBounds(l, &bounds);
+  dirtyAdd(&bounds);
+}
+
+void
+dirtyAddText(Layer *l, const char *string)
+{
+  dirtyAddLayer(l);		/* the old string's pixels */
+  ((AbText *)l->abShape)->string = string;
+  dirtyAddLayer(l);
+}
+
+void
+dirtyFlush(Layer *layers)
+{
+  u_char i;
+  for (i = 0; i < dirtyCount; i++)
+    layerDrawRegion(layers, &dirtyRegions[i]);
+  dirtyCount = 0;
+}
@@ -0,0 +1,55 @@
+/** \file countedShape.h
+ *  \brief Host benchmarks: an AbShape wrapper counting method calls.
+ *
+ *  A CountedShape initialized with COUNTED(shape) forwards to shape,
+ *  adding one to countedProbes for each check or span call and to
+ *  countedBounds for each getBounds call.  Layers take it as their 
+ *  abShape:
+ *
+ *    CountedShape cBall = COUNTED(ball);
+ *    Layer ballLayer = {(AbShape *)&cBall, ...};
+ *
+ *  Defines its functions and counters (static): include it in one
+ *  file of a program.
+ */
+
+#ifndef countedShape_included
+#define countedShape_included
+
+#include "shape.h"
+
+/** Wraps an AbShape, counting calls to its methods */
+typedef struct {
+  void (*getBounds)(const AbShape *shape, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const AbShape *shape, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+  const AbShape *shape;
+} CountedShape;
+
+static unsigned long countedProbes;	/**< check and span calls */
+static unsigned long countedBounds;	/**< getBounds calls */
+
+static void
+countedGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds)
+{
+  countedBounds++;
+  abShapeGetBounds(((const CountedShape *)s)->shape, centerPos, bounds);
+}
+
+static int
+countedCheck(const AbShape *s, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  countedProbes++;
+  return abShapeCheck(((const CountedShape *)s)->shape, centerPos, pixel);
+}
+
+static int
+countedSpan(const AbShape *s, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  countedProbes++;
+  return abShapeSpan(((const CountedShape *)s)->shape, centerPos, geom, row, spans);
+}
+
+#define COUNTED(shape) {countedGetBounds, countedCheck, countedSpan, (const AbShape *)&(shape)}
+
+#endif // included
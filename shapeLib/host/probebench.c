@@ -0,0 +1,101 @@
+/** \file probebench.c
+ *  \brief Host benchmark: shape method calls per pixel when rendering.
+ *
+ *  Renders a scene similar to shape-motion-demo's twice: with the 
+ *  original pixel-by-pixel probe loop, and with layerDraw (span runs).
+ *  Every getBounds, check and span call made through a layer's AbShape
+ *  is counted.  Built with LAYER_GEOM_CACHE=1, layerDraw computes
+ *  each layer's geometry (bounds, and what spans derive from it such
+ *  as a circle's row) once per draw rather than at every probe, and
+ *  with LAYER_BAND_INDEX=1 it skips layers outside a row's band;
+ *  "make host-bench" runs the builds.
+ */
+#include <stdio.h>
+#include <time.h>
+#include "shape.h"
+#include "_abCircle.h"
+#include "countedShape.h"
+
+#define main makeCircles	/* only computeChordVec is wanted */
+#include "../../circleLib/makeCircles.c"
+#undef main
+
+AbRect body = {abRectGetBounds, abRectCheck, abRectSpan, {14, 14}};
+AbRect foot = {abRectGetBounds, abRectCheck, abRectSpan, {6, 4}};
+AbRect eye = {abRectGetBounds, abRectCheck, abRectSpan, {3, 3}};
+AbRect grass = {abRectGetBounds, abRectCheck, abRectSpan, {200, 10}};
+AbRect ground = {abRectGetBounds, abRectCheck, abRectSpan, {200, 40}};
+AbRArrow arrow = {abRArrowGetBounds, abRArrowCheck, abRArrowSpan, 30};
+static u_char sunChords[21], ballChords[9];
+AbCircle sun = {abCircleGetBounds, abCircleCheck, abCircleSpan, sunChords, 20};
+AbCircle ball = {abCircleGetBounds, abCircleCheck, abCircleSpan, ballChords, 8};
+AbRectOutline field = {abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineSpan,
+		       {screenWidth/2-10, screenHeight/2-10}};
+
+CountedShape cBody = COUNTED(body), cFoot = COUNTED(foot), cEye = COUNTED(eye),
+  cGrass = COUNTED(grass), cGround = COUNTED(ground), cArrow = COUNTED(arrow),
+  cField = COUNTED(field), cSun = COUNTED(sun), cBall = COUNTED(ball);
+
+Layer sunL = {(AbShape *)&cSun, {screenWidth-30, 24}, {0,0}, {0,0}, COLOR_YELLOW, 0};
+Layer apple = {(AbShape *)&cArrow, {screenWidth-20, 30}, {0,0}, {0,0}, COLOR_RED, &sunL};
+Layer ground0 = {(AbShape *)&cGround, {screenWidth, screenHeight}, {0,0}, {0,0}, COLOR_CHOCOLATE, &apple};
+Layer grass0 = {(AbShape *)&cGrass, {screenWidth, screenHeight-50}, {0,0}, {0,0}, COLOR_GREEN, &ground0};
+Layer footL = {(AbShape *)&cFoot, {14, screenHeight/2+10}, {0,0}, {0,0}, COLOR_MAGENTA, &grass0};
+Layer bodyL = {(AbShape *)&cBody, {24, screenHeight/2}, {0,0}, {0,0}, COLOR_PINK, &footL};
+Layer eyeL = {(AbShape *)&cEye, {32, screenHeight/2-8}, {0,0}, {0,0}, COLOR_BLACK, &bodyL};
+Layer footR = {(AbShape *)&cFoot, {34, screenHeight/2+10}, {0,0}, {0,0}, COLOR_MAGENTA, &eyeL};
+Layer ballL = {(AbShape *)&cBall, {screenWidth/2, screenHeight/2+20}, {0,0}, {0,0}, COLOR_WHITE, &footR};
+Layer fieldL = {(AbShape *)&cField, {screenWidth/2, screenHeight/2}, {0,0}, {0,0}, COLOR_GRAY, &ballL};
+
+u_int bgColor = COLOR_GRAY;
+
+/** The original renderer: probe every layer at every pixel */
+static void
+pixelDraw(Layer *layers)
+{
+  int row, col;
+  for (row = 0; row < screenHeight; row++) {
+    lcd_setArea(0, row, screenWidth-1, row);
+    for (col = 0; col < screenWidth; col++) {
+      Vec2 pixelPos = {col, row};
+      u_int color = bgColor;
+      Layer *probeLayer;
+      for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) {
+	if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
+	  color = probeLayer->color;
+	  break; 
+	}
+      }
+      lcd_writeColor(color); 
+    }
+  }
+}
+
+#define FRAMES 200
+
+static void
+report(const char *name, void (*draw)(Layer *))
+{
+  const double pixels = (double)FRAMES * screenWidth * screenHeight;
+  clock_t start = clock();
+  int frame;
+  countedProbes = countedBounds = 0;
+  for (frame = 0; frame < FRAMES; frame++)
+    (*draw)(&fieldL);
+  printf("%-27s %8.3f calls/pixel %8.1f ns/pixel\n", name,
+	 (countedProbes + countedBounds) / pixels,
+	 1e9 * (clock() - start) / CLOCKS_PER_SEC / pixels);
+}
+
+int
+main()
+{
+  computeChordVec(sunChords, sun.radius);
+  computeChordVec(ballChords, ball.radius);
+  layerInit(&fieldL);
+  report("per-pixel", pixelDraw);
+  report(LAYER_GEOM_CACHE && LAYER_BAND_INDEX ? "layerDraw, geometry, index"
+	 : LAYER_GEOM_CACHE ? "layerDraw, geometry per draw"
+	 : LAYER_BAND_INDEX ? "layerDraw, band index" : "layerDraw", layerDraw);
+  return 0;
+}
@@ -0,0 +1,110 @@
+/** \file scrollcheck.c
+ *  \brief Host test: a scrolling band drawn by scrollInit and scrollBy.
+ *
+ *  The screen's layers are indexed by layerInit and drawn, then a band
+ *  of other layers (never passed to layerInit) is drawn by scrollInit
+ *  and scrolled through more than its length by scrollBy, with a band
+ *  layer and a screen layer moved along the way.  Each time, every
+ *  pixel the controller stand-in (lcdLib/host/st7735.c) shows is
+ *  compared with the band's layers at the world position it shows, or
+ *  outside the band with the screen's layers.
+ */
+#include <stdio.h>
+#include "shape.h"
+#include "st7735.h"
+
+#define FIRST 30
+#define COUNT 90
+#define AXIS LCD_SCROLL_AXIS
+
+u_int bgColor = COLOR_BLUE;
+
+static AbRect square = {abRectGetBounds, abRectCheck, abRectSpan, {6, 6}};
+static AbRect bar = {abRectGetBounds, abRectCheck, abRectSpan, {10, 3}};
+static AbRArrow arrow = {abRArrowGetBounds, abRArrowCheck, abRArrowSpan, 20};
+
+/* the band's layers, at world positions well past its end */
+static Layer band3 = {(AbShape *)&bar, {50, 250}, {0,0}, {0,0}, COLOR_WHITE, 0};
+static Layer band2 = {(AbShape *)&square, {20, 170}, {0,0}, {0,0}, COLOR_GREEN, &band3};
+static Layer band1 = {(AbShape *)&arrow, {60, 100}, {0,0}, {0,0}, COLOR_RED, &band2};
+static Layer band0 = {(AbShape *)&square, {30, 45}, {0,0}, {0,0}, COLOR_BLACK, &band1};
+
+/* the screen's layers, outside the band */
+static Layer screen1 = {(AbShape *)&bar, {40, FIRST - 8}, {0,0}, {0,0}, COLOR_YELLOW, 0};
+static Layer screen0 = {(AbShape *)&square, {30, FIRST + COUNT + 10}, {0,0}, {0,0}, COLOR_ORANGE, &screen1};
+
+/** color of the first of layers that contains pixel (as abShapeCheck) */
+static u_int
+colorAt(const Layer *layers, int col, int row)
+{
+  Vec2 pixel = {col, row};
+  for (; layers; layers = layers->next)
+    if (abShapeCheck(layers->abShape, &layers->pos, &pixel))
+      return layers->color;
+  return bgColor;
+}
+
+static int
+check(const char *what)
+{
+  int col, row;
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++) {
+      Vec2 pos = {col, row};
+      int p = pos.axes[AXIS];
+      u_int expect;
+      if (p >= FIRST && p < FIRST + COUNT) { /* shows the world scrolled */
+	pos.axes[AXIS] = p + scrollPosition();
+	expect = colorAt(&band0, pos.axes[0], pos.axes[1]);
+      } else
+	expect = colorAt(&screen0, col, row);
+      if (st7735_pixel(col, row) != expect) {
+	printf("%s, scrolled %d: pixel %d,%d is %04x, expected %04x\n", what,
+	       scrollPosition(), col, row, st7735_pixel(col, row), expect);
+	return 1;
+      }
+    }
+  return 0;
+}
+
+int
+main()
+{
+  static const u_char deltas[] = {1, 7, 30, 89, 90, 120, 3, 44};
+  int i;
+  usci_sink = st7735_byte;
+  lcd_init();
+  if (AXIS == 0) {		/* landscape: place layers along columns */
+    Layer *l;
+    for (l = &band0; l; l = l->next) {
+      int t = l->pos.axes[0];
+      l->pos.axes[0] = l->pos.axes[1];
+      l->pos.axes[1] = t;
+    }
+  }
+  layerInit(&screen0);
+  layerDraw(&screen0);
+  scrollInit(&band0, FIRST, COUNT);
+  if (check("scrollInit"))
+    return 1;
+  for (i = 0; i < sizeof(deltas); i++) {
+    scrollBy(deltas[i]);
+    if (check("scrollBy"))
+      return 1;
+    if (i == 2) {		/* move a band layer not yet exposed */
+      band2.pos.axes[AXIS] += 150;
+    } else if (i == 5) {	/* move a screen layer */
+      Region area;
+      screen0.posLast = screen0.pos;
+      screen0.pos.axes[AXIS ^ 1] += 20;
+      layerGetBounds(&screen0, &area);
+      layerDrawRegion(&screen0, &area);
+      if (check("screen layer moved"))
+	return 1;
+    }
+  }
+  printf("band scrolled %d rows (columns), drawn correctly\n", scrollPosition());
+  return 0;
+}
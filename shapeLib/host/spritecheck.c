@@ -0,0 +1,122 @@
+/** \file spritecheck.c
+ *  \brief Host test: AbSprites compiled by makeSprite, drawn by layerDraw.
+ *
+ *  Writes a PPM (several colors and a transparent key) and a PBM,
+ *  reads them back with makeSprite's reader and builds sprites from
+ *  its runs.  Each is drawn by layerDraw over a
+ *  rectangle into the controller stand-in (lcdLib/host/st7735.c), and
+ *  every pixel is compared with the picture; abSpriteCheck is compared
+ *  at every pixel too.
+ */
+#include <stdio.h>
+#include "shape.h"
+#include "st7735.h"
+
+#define main makeSprite		/* only the reader and spriteRuns are wanted */
+#include "../makeSprite.c"
+#undef main
+
+#define WIDTH 61
+#define HEIGHT 23
+
+u_int bgColor = COLOR_BLUE;
+
+static const int rgb[][3] = {	/* picture colors; the first is transparent */
+  {255, 0, 255}, {255, 192, 203}, {0, 0, 0}, {255, 255, 255}, {255, 0, 0}, {10, 200, 30},
+};
+
+// picture color at x, y
+static int
+colorAt(int x, int y)
+{
+  return (x * x + 3 * y + (x >> 3) * y) % 7 % 6;
+}
+
+static void
+writePictures()
+{
+  FILE *ppm = fopen("spritecheck.ppm", "wb"), *pbm = fopen("spritecheck.pbm", "w");
+  int x, y;
+  fprintf(ppm, "P6\n# test picture\n%d %d\n255\n", WIDTH, HEIGHT);
+  fprintf(pbm, "P1\n%d %d\n", WIDTH, HEIGHT);
+  for (y = 0; y < HEIGHT; y++) {
+    for (x = 0; x < WIDTH; x++) {
+      const int *c = rgb[(y == 0 && x == 0) ? 0 : colorAt(x, y)];
+      fprintf(ppm, "%c%c%c", c[0], c[1], c[2]);
+      fprintf(pbm, "%d", colorAt(x, y) == 2);
+    }
+    fprintf(pbm, "\n");
+  }
+  fclose(ppm);
+  fclose(pbm);
+}
+
+// draw sprite over a rectangle and compare every pixel with the picture
+static int
+check(const char *filename, const AbSprite *sprite, int bitmap)
+{
+  AbRect rect = {abRectGetBounds, abRectCheck, abRectSpan, {WIDTH, 4}};
+  Layer rectLayer = {(AbShape *)&rect, {40, 60}, {0,0}, {0,0}, COLOR_YELLOW, 0};
+  Layer spriteLayer = {(AbShape *)sprite, {37, 60}, {0,0}, {0,0}, COLOR_ORANGE, &rectLayer};
+  int left = 37 - WIDTH / 2, top = 60 - HEIGHT / 2, col, row;
+  layerInit(&spriteLayer);
+  layerDraw(&spriteLayer);
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++) {
+      int x = col - left, y = row - top, c = -1;
+      u_int expect;
+      Vec2 pixel = {col, row};
+      if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT) {
+	c = (y == 0 && x == 0) ? 0 : colorAt(x, y);
+	if (bitmap)
+	  c = c == 2 ? 2 : 0;
+      }
+      if (c > 0)
+	expect = bitmap ? COLOR_ORANGE : colorBGR565(rgb[c][0], rgb[c][1], rgb[c][2]);
+      else if (abRectCheck(&rect, &rectLayer.pos, &pixel))
+	expect = COLOR_YELLOW;
+      else
+	expect = bgColor;
+      if (st7735_pixel(col, row) != expect) {
+	printf("%s: pixel %d,%d is %04x, expected %04x\n", filename, col, row,
+	       st7735_pixel(col, row), expect);
+	return 1;
+      }
+      if (!abSpriteCheck(sprite, &spriteLayer.pos, &pixel) != !(c > 0)) {
+	printf("%s: check differs at %d,%d\n", filename, col, row);
+	return 1;
+      }
+    }
+  return 0;
+}
+
+int
+main()
+{
+  static unsigned char runs[3 * WIDTH * HEIGHT];
+  static unsigned int rows[HEIGHT + 1], palette[SPRITE_MAX_COLORS];
+  const char *filenames[] = {"spritecheck.ppm", "spritecheck.pbm"};
+  int i;
+  usci_sink = st7735_byte;
+  lcd_init();
+  writePictures();
+  for (i = 0; i < 2; i++) {
+    Image image;
+    int size, numColors;
+    if (!readImage(filenames[i], &image, SPRITE_TRANSPARENT))
+      return 1;
+    size = spriteRuns(&image, runs, rows, palette, &numColors);
+    {
+      AbSprite sprite = {abSpriteGetBounds, abSpriteCheck, abSpriteSpan,
+			 runs, rows, image.bitmap ? 0 : palette, WIDTH, HEIGHT};
+      if (check(filenames[i], &sprite, image.bitmap))
+	return 1;
+    }
+    printf("%s: %d runs in %d colors drawn correctly\n", filenames[i], size / 3, numColors);
+  }
+  remove(filenames[0]);
+  remove(filenames[1]);
+  return 0;
+}
@@ -0,0 +1,131 @@
+/** \file textcheck.c
+ *  \brief Host test: AbText drawn by layerDraw.
+ *
+ *  Draws a string in each font by layerDraw over a rectangle into the
+ *  controller stand-in (lcdLib/host/st7735.c), and compares every
+ *  pixel with abTextCheck.  The string's rows have more runs than
+ *  SHAPE_MAX_SPANS, so the renderer must resume abTextSpan from the
+ *  column it has reached.  Then the string is lengthened and shortened
+ *  (by dirtyAddText, and in place) and only the damage is repainted.
+ */
+#include <stdio.h>
+#include "shape.h"
+#include "st7735.h"
+
+u_int bgColor = COLOR_BLUE;
+
+static const char *string = "W#M%8@ |i";
+
+// most runs of set pixels in any of text's rows
+static int
+maxRuns(const AbText *text, const Vec2 *pos)
+{
+  Region bounds;
+  int row, most = 0;
+  abTextGetBounds(text, pos, &bounds);
+  for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
+    int col, runs = 0, in = 0;
+    for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0] + 1; col++) {
+      Vec2 pixel = {col, row};
+      int set = abTextCheck(text, pos, &pixel);
+      runs += set && !in;
+      in = set;
+    }
+    if (runs > most)
+      most = runs;
+  }
+  return most;
+}
+
+// compare every pixel with text over rect over bgColor
+static int
+compare(const char *name, const AbText *text, const Layer *textLayer,
+	const AbRect *rect, const Layer *rectLayer)
+{
+  int col, row;
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++) {
+      Vec2 pixel = {col, row};
+      u_int expect;
+      if (abTextCheck(text, &textLayer->pos, &pixel))
+	expect = COLOR_BLACK;
+      else if (abRectCheck(rect, &rectLayer->pos, &pixel))
+	expect = COLOR_YELLOW;
+      else
+	expect = bgColor;
+      if (st7735_pixel(col, row) != expect) {
+	printf("%s: \"%s\": pixel %d,%d is %04x, expected %04x\n", name,
+	       text->string, col, row, st7735_pixel(col, row), expect);
+	return 1;
+      }
+    }
+  return 0;
+}
+
+// repaint the damage and compare
+static int
+flush(const char *name, const AbText *text, Layer *textLayer,
+      const AbRect *rect, const Layer *rectLayer)
+{
+  dirtyFlush(textLayer);
+  lcd_flush();
+  usci_drain();
+  return compare(name, text, textLayer, rect, rectLayer);
+}
+
+// draw text in font over a rectangle and compare every pixel with abTextCheck,
+// then change its length
+static int
+check(const char *name, const Font *font)
+{
+  AbText text = {abTextGetBounds, abTextCheck, abTextSpan, font, string};
+  AbRect rect = {abRectGetBounds, abRectCheck, abRectSpan, {20, 5}};
+  Layer rectLayer = {(AbShape *)&rect, {screenWidth/2, 60}, {0,0}, {0,0}, COLOR_YELLOW, 0};
+  Layer textLayer = {(AbShape *)&text, {screenWidth/2 - 3, 58}, {0,0}, {0,0}, COLOR_BLACK, &rectLayer};
+  char score[6] = "12";
+  if (maxRuns(&text, &textLayer.pos) <= SHAPE_MAX_SPANS) {
+    printf("%s: \"%s\" has too few runs per row\n", name, string);
+    return 1;
+  }
+  layerInit(&textLayer);
+  layerDraw(&textLayer);
+  lcd_flush();
+  usci_drain();
+  if (compare(name, &text, &textLayer, &rect, &rectLayer))
+    return 1;
+  printf("%s: \"%s\" drawn correctly\n", name, string);
+  dirtyAddText(&textLayer, score);
+  if (flush(name, &text, &textLayer, &rect, &rectLayer))
+    return 1;
+  dirtyAddText(&textLayer, "12345");	/* longer */
+  if (flush(name, &text, &textLayer, &rect, &rectLayer))
+    return 1;
+  dirtyAddText(&textLayer, score);	/* shorter */
+  if (flush(name, &text, &textLayer, &rect, &rectLayer))
+    return 1;
+  dirtyAddLayer(&textLayer);		/* in place, longer */
+  score[2] = '3';
+  score[3] = '4';
+  score[4] = 0;
+  dirtyAddLayer(&textLayer);
+  if (flush(name, &text, &textLayer, &rect, &rectLayer))
+    return 1;
+  dirtyAddLayer(&textLayer);		/* in place, shorter */
+  score[1] = 0;
+  dirtyAddLayer(&textLayer);
+  if (flush(name, &text, &textLayer, &rect, &rectLayer))
+    return 1;
+  printf("%s: lengthened and shortened correctly\n", name);
+  return 0;
+}
+
+int
+main()
+{
+  usci_sink = st7735_byte;
+  lcd_init();
+  if (check("font5x7", &font5x7) || check("font8x12", &font8x12)
+      || check("font11x16", &font11x16))
+    return 1;
+  return 0;
+}
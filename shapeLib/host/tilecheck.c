@@ -0,0 +1,135 @@
+/** \file tilecheck.c
+ *  \brief Host test: tileFlush against a full layerDraw.
+ *
+ *  Layers are drawn into the controller stand-in (lcdLib/host/st7735.c),
+ *  then moved and marked with tileAddLayer (and a region with tileAdd).
+ *  After tileFlush every pixel must match what a full layerDraw of the
+ *  moved layers shows.  Counting RAMWR commands checks that a run of
+ *  adjacent marked tiles is repainted through one window, and that
+ *  separate runs each get their own.
+ */
+#include <stdio.h>
+#include "shape.h"
+#include "lcddraw.h"
+#include "st7735.h"
+
+#define RAMWR 0x2c
+
+u_int bgColor = COLOR_BLUE;
+
+static u_int panel[160][160];	/**< what tileFlush left */
+static int windows;		/**< RAMWR commands sent */
+
+static void
+countWindows(unsigned char byte, unsigned char isData)
+{
+  if (!isData && byte == RAMWR)
+    windows++;
+  st7735_byte(byte, isData);
+}
+
+static AbRect square = {abRectGetBounds, abRectCheck, abRectSpan, {5, 5}};
+static AbRArrow arrow = {abRArrowGetBounds, abRArrowCheck, abRArrowSpan, 20};
+
+static Layer layer2 = {(AbShape *)&square, {90, 120}, {0,0}, {0,0}, COLOR_GREEN, 0};
+static Layer layer1 = {(AbShape *)&arrow, {60, 70}, {0,0}, {0,0}, COLOR_RED, &layer2};
+static Layer layer0 = {(AbShape *)&square, {30, 30}, {0,0}, {0,0}, COLOR_BLACK, &layer1};
+
+/** Move l by col, row and mark its old and new bounds */
+static void
+move(Layer *l, int col, int row)
+{
+  l->posLast = l->pos;
+  l->pos.axes[0] += col;
+  l->pos.axes[1] += row;
+  tileAddLayer(l);
+}
+
+/** Flush the marked tiles and compare the panel with a full redraw */
+static int
+check(const char *what)
+{
+  int col, row;
+  tileFlush(&layer0);
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++)
+      panel[row][col] = st7735_pixel(col, row);
+  layerDraw(&layer0);
+  lcd_flush();
+  usci_drain();
+  for (row = 0; row < screenHeight; row++)
+    for (col = 0; col < screenWidth; col++)
+      if (panel[row][col] != st7735_pixel(col, row)) {
+	printf("%s: pixel %d,%d is %04x, expected %04x\n", what, col, row,
+	       panel[row][col], st7735_pixel(col, row));
+	return 1;
+      }
+  return 0;
+}
+
+/** Windows tileFlush opens for damage */
+static int
+flushWindows(const Region *damage, int numDamage)
+{
+  int i;
+  lcd_flush();
+  usci_drain();
+  windows = 0;
+  for (i = 0; i < numDamage; i++)
+    tileAdd(&damage[i]);
+  tileFlush(&layer0);
+  lcd_flush();
+  usci_drain();
+  return windows;
+}
+
+int
+main()
+{
+  /* tile row 4: columns 2 to 5 (adjacent), then 2, 3 and 6 (two runs) */
+  static const Region adjacent[] = {{{17, 33}, {30, 35}}, {{31, 36}, {44, 39}}};
+  static const Region apart[] = {{{16, 32}, {31, 39}}, {{50, 34}, {52, 34}}};
+  static const Region twoRows[] = {{{16, 32}, {47, 47}}};
+  int n;
+  usci_sink = countWindows;
+  lcd_init();
+  layerInit(&layer0);
+  layerDraw(&layer0);
+
+  move(&layer0, 3, 1);		/* small moves: old and new bounds overlap */
+  move(&layer1, -7, 12);
+  if (check("layers moved"))
+    return 1;
+  move(&layer2, 0, -60);	/* a jump: two separate areas */
+  {
+    Region fill = {{100, 10}, {120, 14}};
+    fillRectangle(100, 10, 21, 5, COLOR_WHITE); /* e.g. text to erase */
+    tileAdd(&fill);
+  }
+  if (check("layer jumped, rectangle erased"))
+    return 1;
+  move(&layer1, 200, 0);	/* off screen */
+  if (check("layer left the screen"))
+    return 1;
+
+  if ((n = flushWindows(adjacent, 2)) != 1) {
+    printf("adjacent tiles: %d windows, expected 1\n", n);
+    return 1;
+  }
+  if ((n = flushWindows(apart, 2)) != 2) {
+    printf("separate tiles: %d windows, expected 2\n", n);
+    return 1;
+  }
+  if ((n = flushWindows(twoRows, 1)) != 2) {
+    printf("two tile rows: %d windows, expected 2\n", n);
+    return 1;
+  }
+  if ((n = flushWindows(twoRows, 0)) != 0) {
+    printf("nothing marked: %d windows, expected 0\n", n);
+    return 1;
+  }
+  printf("tileFlush matches layerDraw, one window per run of tiles\n");
+  return 0;
+}
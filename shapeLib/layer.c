@@ -2,25 +2,269 @@
 #include "lcddraw.h"
 #include "shape.h"
 
+/** Number of color runs buffered before they are streamed to the lcd */
+#define LAYER_RUN_BUFFER 8
+
+/** Probe one layer for the run of row that begins at col.
+ *
+ *  geom is the layer's geometry cached for this draw, or 0 to compute
+ *  it for this probe only.
+ *
+ *  \return 1 if the layer covers col, in which case *colEnd is trimmed
+ *  to where its coverage ends and *color is set.  Otherwise 0, and 
+ *  *colEnd is trimmed to just before the layer's coverage begins.
+ */
+static u_char
+layerProbe(const Layer *l, ShapeGeom *geom, int row, int col, int *colEnd, u_int *color)
+{
+  const AbShape *shape = l->abShape;
+  ShapeGeom probeGeom;
+  const Region *bounds;
+  if (!geom) {
+    geom = &probeGeom;
+    abShapeGeom(shape, &l->pos, geom);
+  }
+  bounds = &geom->bounds;
+  if (row < bounds->topLeft.axes[1] || row > bounds->botRight.axes[1]
+      || col > bounds->botRight.axes[0])
+    return 0;
+  if (shape->span) {
+    Span spans[SHAPE_MAX_SPANS];
+    int i, numSpans;
+    spans[0].colStart = col;	/* runs before col aren't needed */
+    for (i = 0; i < SHAPE_MAX_SPANS; i++)
+      spans[i].color = l->color; /* unless the shape colors its runs */
+    numSpans = abShapeSpan(shape, &l->pos, geom, row, spans);
+    for (i = 0; i < numSpans; i++) {
+      if (spans[i].colStart > col) { /* begins later: ends this run */
+	if (spans[i].colStart <= *colEnd)
+	  *colEnd = spans[i].colStart - 1;
+      } else if (spans[i].colEnd >= col) { /* covers col */
+	if (spans[i].colEnd < *colEnd)
+	  *colEnd = spans[i].colEnd;
+	*color = spans[i].color;
+	return 1;
+      }
+    }
+  } else {			/* no span method: fall back to check */
+    if (col < bounds->topLeft.axes[0]) {
+      if (bounds->topLeft.axes[0] <= *colEnd)
+	*colEnd = bounds->topLeft.axes[0] - 1;
+      return 0;
+    }
+    Vec2 pixelPos = {col, row};
+    *colEnd = col;		/* next pixel must be checked again */
+    if (!abShapeCheck(shape, &l->pos, &pixelPos))
+      return 0;
+    *color = l->color;
+    return 1;
+  }
+  return 0;
+}
+
+#if LAYER_GEOM_CACHE
+/** Compute the geometry of the first LAYER_GEOM_MAX layers for a draw */
+static void
+layerGeomsInit(const Layer *layers, ShapeGeom *geoms)
+{
+  u_char i;
+  for (i = 0; layers && i < LAYER_GEOM_MAX; layers = layers->next, i++)
+    abShapeGeom(layers->abShape, &layers->pos, &geoms[i]);
+}
+#endif
+
+/** Layer i's geometry cached for this draw (geoms), or 0 if it isn't */
+#define LAYER_GEOM(geoms, i) ((geoms) && (i) < LAYER_GEOM_MAX ? &(geoms)[i] : 0)
+
+#if LAYER_BAND_INDEX
+/** Index the first LAYER_INDEX_MAX layers by the bands of rows 
+ *  rowFirst..rowLast that their bounds reach: bit i of bands[b] is set
+ *  if layer i reaches a row of rowFirst + b*LAYER_BAND_ROWS onwards.
+ *
+ *  \return bands, or 0 if there are too many rows to index
+ */
+static u_char *
+layerBandsInit(const Layer *layers, const ShapeGeom *geoms, u_char *bands,
+	       int rowFirst, int rowLast)
+{
+  u_char i, band;
+  if (rowLast - rowFirst >= LAYER_BANDS * LAYER_BAND_ROWS)
+    return 0;
+  for (band = 0; band < LAYER_BANDS; band++)
+    bands[band] = 0;
+  for (i = 0; layers && i < LAYER_INDEX_MAX; layers = layers->next, i++) {
+    Region layerBounds;
+    const Region *bounds = &layerBounds;
+    int top, bottom;
+    if (geoms && i < LAYER_GEOM_MAX)
+      bounds = &geoms[i].bounds;
+    else
+      abShapeGetBounds(layers->abShape, &layers->pos, &layerBounds);
+    top = bounds->topLeft.axes[1] < rowFirst ? rowFirst : bounds->topLeft.axes[1];
+    bottom = bounds->botRight.axes[1] > rowLast ? rowLast : bounds->botRight.axes[1];
+    if (top > bottom)
+      continue;			/* doesn't reach the rows drawn */
+    for (band = (top - rowFirst) >> LAYER_BAND_SHIFT;
+	 band <= (bottom - rowFirst) >> LAYER_BAND_SHIFT; band++)
+      bands[band] |= 1 << i;
+  }
+  return bands;
+}
+#endif // LAYER_BAND_INDEX
+
+/** Resolve the run of row that begins at col.
+ *
+ *  Layers are probed in order.  The first layer covering col determines
+ *  *color.  The run ends where that layer's coverage ends or where a
+ *  higher (earlier) layer's coverage begins, whichever comes first.
+ *  Layers without a span method are checked one pixel at a time within 
+ *  their bounding box.  If band is not 0, of the first LAYER_INDEX_MAX
+ *  layers only those whose bits it sets (those whose bounds reach row's
+ *  band) are probed.
+ *
+ *  \return last column of the run (at most colEnd)
+ */
+static int
+layerProbeRun(Layer *layers, ShapeGeom *geoms, const u_char *band,
+	      int row, int col, int colEnd, u_int *color)
+{
+  Layer *probeLayer;
+  u_char i, candidates = band ? *band : 0xff;
+  *color = bgColor;
+  for (probeLayer = layers, i = 0; probeLayer;
+       probeLayer = probeLayer->next, i++, candidates >>= 1) {
+    if (i < LAYER_INDEX_MAX && !(candidates & 1))
+      continue;			/* doesn't reach row's band */
+    if (layerProbe(probeLayer, LAYER_GEOM(geoms, i), row, col, &colEnd, color))
+      break;
+  } // for checking layers at col, row
+  return colEnd;
+}
+
+/** row's band of the index for area, if there is one */
+#if LAYER_BAND_INDEX
+#define LAYER_BAND(bands, area, row) \
+  ((bands) ? &(bands)[((row) - (area)->topLeft.axes[1]) >> LAYER_BAND_SHIFT] : 0)
+#else
+#define LAYER_BAND(bands, area, row) 0
+#endif
+
+#if LAYER_LINE_BUFFER
+
+static u_char layerLines[2][screenWidth * 2];
+static u_char layerLineCur = 0;	/**< line buffer being filled */
+
+/** Send the current line buffer and switch to the other one once it
+ *  has been completely sent.
+ */
+static u_char *
+layerNextLine(u_char *line, u_int used)
+{
+  lcd_writeBuffer(line, used);
+  layerLineCur ^= 1;
+  lcd_waitBuffers(1);		/* other buffer may still be being sent */
+  return layerLines[layerLineCur];
+}
+
 void
-layerDraw(Layer *layers)
+layerDrawRegionShifted(Layer *layers, const Region *area, const Vec2 *shift)
 {
-  int row, col;
-  for (row = 0; row < screenHeight; row++) {
-    lcd_setArea(0, row, screenWidth-1, row);
-    for (col = 0; col < screenWidth; col++) {
-      Vec2 pixelPos = {col, row};
-      u_int color = bgColor;
-      Layer *probeLayer;
-      for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) {
-	if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	  color = probeLayer->color;
-	  break; 
-	} /* if check */
-      } // for checking all layers at col, row
-      lcd_writeColor(color); 
-    } // for col
+  int row, col, colEnd;
+  int colMin = area->topLeft.axes[0], colMax = area->botRight.axes[0];
+  int dCol = shift->axes[0], dRow = shift->axes[1];
+  u_char *line = layerLines[layerLineCur];
+  u_int used = 0;
+#if LAYER_GEOM_CACHE
+  ShapeGeom geoms[LAYER_GEOM_MAX];
+  layerGeomsInit(layers, geoms);
+#else
+  ShapeGeom *geoms = 0;
+#endif
+#if LAYER_BAND_INDEX
+  u_char bandMasks[LAYER_BANDS];
+  u_char *bands = layerBandsInit(layers, geoms, bandMasks, area->topLeft.axes[1] + dRow,
+				 area->botRight.axes[1] + dRow);
+#endif
+  lcd_setArea(colMin, area->topLeft.axes[1], colMax, area->botRight.axes[1]);
+  for (row = area->topLeft.axes[1]; row <= area->botRight.axes[1]; row++) {
+    for (col = colMin; col <= colMax; col = colEnd + 1) {
+      u_int color, count;
+      colEnd = layerProbeRun(layers, geoms, LAYER_BAND(bands, area, row),
+			     row + dRow, col + dCol, colMax + dCol,
+			     &color) - dCol;
+      for (count = colEnd - col + 1; count; count--) {
+	if (used == sizeof(layerLines[0])) {
+	  line = layerNextLine(line, used);
+	  used = 0;
+	}
+	line[used++] = color >> 8;
+	line[used++] = color;
+      }
+    } // for each run in row
+    line = layerNextLine(line, used); /* send row while compositing next */
+    used = 0;
   } // for row
+}
+
+#else // !LAYER_LINE_BUFFER
+
+void
+layerDrawRegionShifted(Layer *layers, const Region *area, const Vec2 *shift)
+{
+  int row, col, colEnd;
+  int colMin = area->topLeft.axes[0], colMax = area->botRight.axes[0];
+  int dCol = shift->axes[0], dRow = shift->axes[1];
+  ColorSpan runs[LAYER_RUN_BUFFER];
+  u_char numRuns = 0;
+#if LAYER_GEOM_CACHE
+  ShapeGeom geoms[LAYER_GEOM_MAX];
+  layerGeomsInit(layers, geoms);
+#else
+  ShapeGeom *geoms = 0;
+#endif
+#if LAYER_BAND_INDEX
+  u_char bandMasks[LAYER_BANDS];
+  u_char *bands = layerBandsInit(layers, geoms, bandMasks, area->topLeft.axes[1] + dRow,
+				 area->botRight.axes[1] + dRow);
+#endif
+  lcd_setArea(colMin, area->topLeft.axes[1], colMax, area->botRight.axes[1]);
+  for (row = area->topLeft.axes[1]; row <= area->botRight.axes[1]; row++) {
+    for (col = colMin; col <= colMax; col = colEnd + 1) {
+      u_int color;
+      u_char count;
+      colEnd = layerProbeRun(layers, geoms, LAYER_BAND(bands, area, row),
+			     row + dRow, col + dCol, colMax + dCol,
+			     &color) - dCol;
+      count = colEnd - col + 1;
+      if (numRuns && runs[numRuns-1].colorBGR == color 
+	  && runs[numRuns-1].count <= 255 - count) {
+	runs[numRuns-1].count += count; /* continues previous run */
+	continue;
+      }
+      if (numRuns == LAYER_RUN_BUFFER) {
+	lcd_writeColorSpans(runs, numRuns);
+	numRuns = 0;
+      }
+      runs[numRuns].colorBGR = color;
+      runs[numRuns++].count = count;
+    } // for each run in row
+  } // for row
+  lcd_writeColorSpans(runs, numRuns);
+}
+
+#endif // LAYER_LINE_BUFFER
+
+void
+layerDrawRegion(Layer *layers, const Region *area)
+{
+  layerDrawRegionShifted(layers, area, &vec2Zero);
+}
+
+void
+layerDraw(Layer *layers)
+{
+  Region screen = {{0, 0}, {screenWidth-1, screenHeight-1}};
+  layerDrawRegion(layers, &screen);
 } 
 
 
@@ -36,9 +280,10 @@ layerGetBounds(const Layer *l, Region *bounds)
 }
 
 void
-layerInit(Layer *layer)
+layerInit(Layer *layers)
 {
-  for (; layer; layer = layer->next)
+  Layer *layer;
+  for (layer = layers; layer; layer = layer->next)
     layer->posLast = layer->posNext = layer->pos;
 }
 
@@ -0,0 +1,242 @@
+
+///////////////////////////////////////////
+// makeSprite: compile a PBM or PPM picture into an AbSprite
+//
+// usage: makeSprite <name> <picture.pbm|picture.ppm> [<transparent RRGGBB>|none]
+//   e.g. makeSprite kirby kirby.ppm ff00ff
+//
+// Writes <name>.c, defining the AbSprite <name>, and <name>.h declaring
+// it.  Each row becomes a list of runs (first column, length, palette
+// index) of one color; transparent pixels are not stored.  PPM colors
+// are converted to BGR565 and collected in a palette; a PPM's
+// transparent color defaults to its top left pixel's.  A PBM's set
+// (black) pixels are drawn in the layer's color and its clear pixels
+// are transparent.  Both the plain (P1, P3) and raw (P4, P6) formats
+// are read.
+///////////////////////////////////////////
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "assert.h"
+
+#define SPRITE_TRANSPARENT -1L	/* pixel value of transparent pixels */
+#define SPRITE_MAX_COLORS 256
+
+typedef struct {
+  int width, height;
+  int bitmap;			/* from a PBM: set pixels have value 0 */
+  long *pixels;			/* row by row: BGR565 or SPRITE_TRANSPARENT */
+} Image;
+
+// next number in a PNM header or plain raster, skipping # comments;
+// consumes the single whitespace character that ends it
+static long readNumber(FILE *fp)
+{
+  long n = 0;
+  int c = getc(fp);
+  for (;;) {
+    if (c == '#')
+      while (c != '\n' && c != EOF)
+	c = getc(fp);
+    else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+      c = getc(fp);
+    else
+      break;
+  }
+  assert(c >= '0' && c <= '9');
+  for (; c >= '0' && c <= '9'; c = getc(fp))
+    n = n * 10 + c - '0';
+  return n;
+}
+
+// next plain PBM pixel, which need not be separated from the next
+static int readPlainBit(FILE *fp)
+{
+  int c;
+  do
+    c = getc(fp);
+  while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+  assert(c == '0' || c == '1');
+  return c - '0';
+}
+
+// next PPM sample scaled to 0..255
+static int readSample(FILE *fp, int format, long maxval)
+{
+  long v;
+  if (format == 3)
+    v = readNumber(fp);
+  else if (maxval < 256)
+    v = getc(fp);
+  else {
+    v = getc(fp) << 8;
+    v |= getc(fp);
+  }
+  assert(v >= 0 && v <= maxval);
+  return (v * 255 + maxval / 2) / maxval;
+}
+
+// BGR565 (as lcdutils' COLOR_*) of 8 bit red, green and blue
+long colorBGR565(int red, int green, int blue)
+{
+  return ((long)(blue >> 3) << 11) | ((green >> 2) << 5) | (red >> 3);
+}
+
+///////////////////////////////////////////
+// read a PBM or PPM file.  transparent is the RRGGBB color of
+// transparent pixels in a PPM, SPRITE_TRANSPARENT to use the top left
+// pixel's, or -2 for none.  Returns 0 if the file can't be read.
+///////////////////////////////////////////
+int readImage(const char *filename, Image *image, long transparent)
+{
+  FILE *fp = fopen(filename, "rb");
+  int format, x, y;
+  long maxval = 1;
+  if (!fp)
+    return 0;
+  if (getc(fp) != 'P') {
+    fclose(fp);
+    return 0;
+  }
+  format = getc(fp) - '0';
+  assert(format == 1 || format == 3 || format == 4 || format == 6);
+  image->width = readNumber(fp);
+  image->height = readNumber(fp);
+  image->bitmap = (format == 1 || format == 4);
+  if (!image->bitmap)
+    maxval = readNumber(fp);
+  assert(maxval > 0 && maxval < 65536);
+  image->pixels = malloc(sizeof(long) * image->width * image->height);
+  assert(image->pixels);
+  for (y = 0; y < image->height; y++) {
+    int byte = 0;
+    for (x = 0; x < image->width; x++) {
+      long *pixel = &image->pixels[y * image->width + x];
+      if (format == 4) {	/* rows are padded to whole bytes */
+	if (!(x & 7))
+	  byte = getc(fp);
+	*pixel = (byte << (x & 7)) & 0x80 ? 0 : SPRITE_TRANSPARENT;
+      } else if (format == 1)
+	*pixel = readPlainBit(fp) ? 0 : SPRITE_TRANSPARENT;
+      else {
+	int red = readSample(fp, format, maxval);
+	int green = readSample(fp, format, maxval);
+	int blue = readSample(fp, format, maxval);
+	long rgb = ((long)red << 16) | (green << 8) | blue;
+	if (x == 0 && y == 0 && transparent == SPRITE_TRANSPARENT)
+	  transparent = rgb;
+	*pixel = rgb == transparent ? SPRITE_TRANSPARENT : colorBGR565(red, green, blue);
+      }
+    }
+  }
+  assert(!feof(fp));
+  fclose(fp);
+  return 1;
+}
+
+///////////////////////////////////////////
+// build the runs (first column, length, palette index) of each row of
+// image, rows[] (offset of each row's first run, and the end), and the
+// palette of its colors.  Returns the size of runs in bytes.
+///////////////////////////////////////////
+int spriteRuns(const Image *image, unsigned char runs[], unsigned int rows[],
+	       unsigned int palette[], int *numColors)
+{
+  int x, y, size = 0;
+  *numColors = 0;
+  for (y = 0; y < image->height; y++) {
+    const long *row = &image->pixels[y * image->width];
+    rows[y] = size;
+    for (x = 0; x < image->width; ) {
+      long color = row[x];
+      int start = x, index;
+      if (color == SPRITE_TRANSPARENT) {
+	x++;
+	continue;
+      }
+      while (x < image->width && row[x] == color && x - start < 255)
+	x++;
+      for (index = 0; index < *numColors && palette[index] != color; index++)
+	;
+      if (index == *numColors) {
+	assert(*numColors < SPRITE_MAX_COLORS);
+	palette[(*numColors)++] = color;
+      }
+      runs[size++] = start;
+      runs[size++] = x - start;
+      runs[size++] = index;
+    }
+  }
+  rows[image->height] = size;
+  assert(size < 65536);
+  return size;
+}
+
+int main(int argc, char **argv)
+{
+  const char *name, *imageName;
+  char filename[100];
+  long transparent = SPRITE_TRANSPARENT;
+  Image image;
+  unsigned char *runs;
+  unsigned int *rows, palette[SPRITE_MAX_COLORS];
+  int size, numColors, i, y;
+  FILE *fp;
+
+  if (argc == 4)
+    transparent = strcmp(argv[3], "none") ? strtol(argv[3], 0, 16) : -2;
+  if (argc < 3 || argc > 4 || !readImage(argv[2], &image, transparent)) {
+    fprintf(stderr, "usage: %s <name> <picture.pbm|picture.ppm> [<transparent RRGGBB>|none]\n",
+	    argv[0]);
+    return 1;
+  }
+  name = argv[1];
+  imageName = strrchr(argv[2], '/') ? strrchr(argv[2], '/') + 1 : argv[2];
+  assert(image.width > 0 && image.width <= 255 && image.height > 0 && image.height <= 255);
+  runs = malloc(3 * image.width * image.height);
+  rows = malloc(sizeof(unsigned int) * (image.height + 1));
+  assert(runs && rows);
+  size = spriteRuns(&image, runs, rows, palette, &numColors);
+
+  sprintf(filename, "%s.c", name);
+  fp = fopen(filename, "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeSprite from %s\n", imageName);
+  fprintf(fp, "#include \"shape.h\"\n\n");
+  fprintf(fp, "static const unsigned char %s_runs[%d] = {\n", name, size ? size : 1);
+  for (y = 0; y < image.height; y++) {
+    fprintf(fp, "   ");
+    for (i = rows[y]; i < (int)rows[y + 1]; i += 3)
+      fprintf(fp, " %d, %d, %d,", runs[i], runs[i + 1], runs[i + 2]);
+    fprintf(fp, " // row %d\n", y);
+  }
+  fprintf(fp, "};\n\n");
+  fprintf(fp, "static const unsigned int %s_rows[%d] = {", name, image.height + 1);
+  for (y = 0; y <= image.height; y++)
+    fprintf(fp, "%s%d,", (y % 12) ? " " : "\n    ", rows[y]);
+  fprintf(fp, "\n};\n\n");
+  if (!image.bitmap) {
+    fprintf(fp, "static const unsigned int %s_palette[%d] = {\n", name, numColors ? numColors : 1);
+    for (i = 0; i < numColors; i++)
+      fprintf(fp, "    0x%04x,\n", palette[i]);
+    fprintf(fp, "};\n\n");
+  }
+  fprintf(fp, "const AbSprite %s = {\n  abSpriteGetBounds, abSpriteCheck, abSpriteSpan,\n", name);
+  fprintf(fp, "  %s_runs, %s_rows, %s%s, %d, %d\n};\n", name, name,
+	  image.bitmap ? "0" : name, image.bitmap ? "" : "_palette", image.width, image.height);
+  fclose(fp);
+
+  sprintf(filename, "%s.h", name);
+  fp = fopen(filename, "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeSprite from %s\n", imageName);
+  fprintf(fp, "#ifndef %s_included\n#define %s_included\n\n", name, name);
+  fprintf(fp, "#include \"shape.h\"\n\n");
+  fprintf(fp, "extern const AbSprite %s;\n\n#endif // included\n", name);
+  fclose(fp);
+
+  printf("%s: %dx%d, %d runs in %d colors, %d bytes\n", name, image.width, image.height,
+	 size / 3, numColors, size + 2 * (image.height + 1) + 2 * numColors);
+  return 0;
+}
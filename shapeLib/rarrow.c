@@ -23,6 +23,36 @@ abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixel)
   }
   return within;
 }
+
+/** Span function required by AbShape
+ *  abRArrowSpan computes the single run of row within the right arrow.
+ *  Tip and stem are contiguous, so rows within the stem's height run 
+ *  from the stem's tail to the tip's edge.  The tail and tip columns
+ *  and the top and bottom rows are the arrow's bounds; the stem's half
+ *  height and the tip's back column are derived once per position.
+ */
+int
+abRArrowSpan(const AbRArrow *arrow, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  const Region *bounds = &geom->bounds;
+  int colTip = bounds->botRight.axes[0];
+  if (row < bounds->topLeft.axes[1] || row > bounds->botRight.axes[1])
+    return 0;
+  if (!geom->derivedValid) {
+    int halfSize = arrow->size/2;
+    geom->derived[0] = halfSize/2;	 /* stem's half height */
+    geom->derived[1] = colTip - halfSize; /* tip's back column */
+    geom->derivedValid = 1;
+  }
+  row -= centerPos->axes[1];
+  row = (row >= 0) ? row : -row;/* row = |row| */
+  if (row <= geom->derived[0])	/* stem and tip */
+    spans[0].colStart = bounds->topLeft.axes[0];
+  else				/* tip only */
+    spans[0].colStart = geom->derived[1];
+  spans[0].colEnd = colTip - row;
+  return 1;
+}
   
 /** Check function required by AbShape
  *  abRArrowGetBounds computes a right arrow's bounding box
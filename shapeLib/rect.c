@@ -4,15 +4,26 @@
 int 
 abRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
 {
-  Region bounds;
-  abRectGetBounds(rect, centerPos, &bounds);
-  int within = 1, axis;
+  u_char axis;
   for (axis = 0; axis < 2; axis ++) {
-    int p = pixel->axes[axis];
-    if (p > bounds.botRight.axes[axis] || p < bounds.topLeft.axes[axis])
-      within = 0;
+    int dist = pixel->axes[axis] - centerPos->axes[axis];
+    int half = rect->halfSize.axes[axis];
+    if (dist > half || dist < -half)
+      return 0;
   }
-  return within;
+  return 1;
+}
+
+// the single span of row covered by rect with the given bounds
+int
+abRectSpan(const AbRect *rect, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  const Region *bounds = &geom->bounds;
+  if (row < bounds->topLeft.axes[1] || row > bounds->botRight.axes[1])
+    return 0;
+  spans[0].colStart = bounds->topLeft.axes[0];
+  spans[0].colEnd = bounds->botRight.axes[0];
+  return 1;
 }
 
 // compute bounding box in screen coordinates for rect at centerPos
@@ -28,18 +39,31 @@ void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds)
 int 
 abRectOutlineCheck(const AbRectOutline *rect, const Vec2 *centerPos, const Vec2 *pixel)
 {
-  Region bounds;
-  abRectOutlineGetBounds(rect, centerPos, &bounds);
-  int col = pixel->axes[0], row = pixel->axes[1];
-  return (
-	  ((col == bounds.topLeft.axes[0] || col == bounds.botRight.axes[0])
-	   && 
-	   (row >= bounds.topLeft.axes[1] && row <= bounds.botRight.axes[1]))
-	  ||
-	  ((row == bounds.topLeft.axes[1] || row == bounds.botRight.axes[1])
-	   &&
-	   (col >= bounds.topLeft.axes[0] && col <= bounds.botRight.axes[0]))
-	  );
+  int col = pixel->axes[0] - centerPos->axes[0];
+  int row = pixel->axes[1] - centerPos->axes[1];
+  int halfCols = rect->halfSize.axes[0], halfRows = rect->halfSize.axes[1];
+  col = (col >= 0) ? col : -col; /* project to first quadrant */
+  row = (row >= 0) ? row : -row;
+  return ((col == halfCols && row <= halfRows) ||
+	  (row == halfRows && col <= halfCols));
+}
+
+// top & bottom rows are one span, rows between are the two side pixels
+int
+abRectOutlineSpan(const AbRectOutline *rect, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  const Region *bounds = &geom->bounds;
+  int left = bounds->topLeft.axes[0], right = bounds->botRight.axes[0];
+  if (row < bounds->topLeft.axes[1] || row > bounds->botRight.axes[1])
+    return 0;
+  if (row == bounds->topLeft.axes[1] || row == bounds->botRight.axes[1] || left == right) {
+    spans[0].colStart = left;
+    spans[0].colEnd = right;
+    return 1;
+  }
+  spans[0].colStart = spans[0].colEnd = left;
+  spans[1].colStart = spans[1].colEnd = right;
+  return 2;
 }
  
 // compute bounding box in screen coordinates for rect at centerPos
@@ -49,5 +73,3 @@ void abRectOutlineGetBounds(const AbRectOutline *rect, const Vec2 *centerPos, Re
   vec2Add(&bounds->botRight, centerPos, &rect->halfSize);
 }
 
-
-
@@ -0,0 +1,69 @@
+#include "lcdutils.h"
+#include "shape.h"
+
+/** Scrolling background band (see scrollInit).
+ *  World position w along the scroll axis is kept in lcd memory at
+ *  scrollFirst + (w - scrollFirst) mod scrollCount.
+ */
+static Layer *scrollLayers = 0;
+static u_char scrollFirst, scrollCount;
+static u_char scrollOffset = 0;	/**< lcd scroll offset: scrollPos mod count */
+static int scrollPos = 0;	/**< rows (columns) scrolled so far */
+
+/** Draw n world positions starting at worldPos into band memory 
+ *  starting at addr, wrapping at the end of the band.
+ */
+static void
+scrollDraw(u_char addr, int worldPos, u_char n)
+{
+  Region area;
+  Vec2 shift = {0, 0};
+  u_char axis = LCD_SCROLL_AXIS, end = scrollFirst + scrollCount;
+  area.topLeft.axes[axis ^ 1] = 0;
+  area.botRight.axes[axis ^ 1] = (axis ? screenWidth : screenHeight) - 1;
+  while (n) {
+    u_char len = end - addr;	/* up to where the band wraps */
+    if (len > n)
+      len = n;
+    area.topLeft.axes[axis] = addr;
+    area.botRight.axes[axis] = addr + len - 1;
+    shift.axes[axis] = worldPos - addr;
+    layerDrawRegionShifted(scrollLayers, &area, &shift);
+    addr = scrollFirst;
+    worldPos += len;
+    n -= len;
+  }
+}
+
+void
+scrollInit(Layer *layers, u_char first, u_char count)
+{
+  scrollLayers = layers;
+  scrollFirst = first;
+  scrollCount = count;
+  scrollOffset = 0;
+  scrollPos = 0;
+  lcd_setScrollArea(first, count);
+  scrollDraw(first, first, count);
+}
+
+void
+scrollBy(u_char delta)
+{
+  u_char addr = scrollFirst + scrollOffset; /* where exposed positions go */
+  int worldPos = scrollFirst + scrollPos + scrollCount;
+  if (delta > scrollCount)
+    delta = scrollCount;
+  scrollOffset += delta;
+  if (scrollOffset >= scrollCount)
+    scrollOffset -= scrollCount;
+  scrollPos += delta;
+  lcd_scrollTo(scrollOffset);
+  scrollDraw(addr, worldPos, delta);
+}
+
+int
+scrollPosition()
+{
+  return scrollPos;
+}
@@ -16,9 +16,21 @@ abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds)
   (*s->getBounds)(s, centerPos, bounds);
 }
 
+void
+abShapeGeom(const AbShape *s, const Vec2 *centerPos, ShapeGeom *geom)
+{
+  (*s->getBounds)(s, centerPos, &geom->bounds);
+  geom->derivedValid = 0;
+}
+
 int
 abShapeCheck(const AbShape *s, const Vec2 *centerPos, const Vec2 *pixelLoc)
 {
   return (*s->check)(s, centerPos, pixelLoc);
 }
 
+int
+abShapeSpan(const AbShape *s, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  return (*s->span)(s, centerPos, geom, row, spans);
+}
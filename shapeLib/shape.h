@@ -62,6 +62,36 @@ void regionUnion(Region *rUnion, const Region *r1, const Region *r2);
  */
 void regionClipScreen(Region *region);
 
+/** A horizontal run of pixels within a single row.
+ *
+ *  colStart and colEnd are both inclusive screen columns.  color is
+ *  the run's color for shapes of more than one color (AbSprite): on 
+ *  entry to a span method every span's color is the layer's, and 
+ *  other shapes leave it alone.
+ */
+typedef struct {
+  int colStart, colEnd;
+  u_int color;
+} Span;
+
+/** Maximum number of spans any AbShape reports for a single row */
+#define SHAPE_MAX_SPANS 2
+
+/** Geometry of a shape at one position, kept by a renderer across rows
+ *
+ *  bounds is what the shape's getBounds computes.  derived holds 
+ *  values a span method computes from the position and keeps while
+ *  the renderer reuses geom (e.g. an arrow's tip column, the row a 
+ *  circle measured last); what they mean is up to the shape.  They are 
+ *  computed on the first span call after abShapeGeom, which clears
+ *  derivedValid.
+ */
+typedef struct {
+  Region bounds;
+  int derived[2];
+  u_char derivedValid;
+} ShapeGeom;
+
 /** This function initializes the screen
  *  vectors that are used by shapes
  *
@@ -72,17 +102,29 @@ void shapeInit();
 /** Effectively a base class for Abstract Shapes
  *  
  *  Abstract Shapes have a shape but no position or color.
- *  The first two fields MUST BE pointers to
+ *  The first three fields MUST BE pointers to
  *
  *  getBounds: A function that computes the bounding box for the AbShape
  *  when rendered at coordinate centerPos
  * 
  *  check: A function that determines if the AbShape contains pixelLoc when 
  *  rendered at centerPos
+ *
+ *  span: (optional, may be 0) A function that stores the horizontal runs 
+ *  the AbShape covers in row when rendered at centerPos into spans[]
+ *  (at most SHAPE_MAX_SPANS of them) and returns how many it stored.
+ *  geom must have been set up by abShapeGeom for centerPos; callers 
+ *  that render many rows may do that once (see LAYER_GEOM_CACHE), 
+ *  and span methods keep what they derive from centerPos in it.  On 
+ *  entry spans[0].colStart is the
+ *  first column the caller needs: shapes with more runs per row than
+ *  SHAPE_MAX_SPANS (such as AbText) report the runs from there on.
+ *  Renderers fall back to check for shapes without one.
  */
 typedef struct AbShape_s {		/* base type for all abstrct shapes */
   void (*getBounds)(const struct AbShape_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbShape_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  int (*span)(const struct AbShape_s *shape, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
 } AbShape;
 
 /** Computes bounding box of abShape in screen coordinates 
@@ -93,6 +135,14 @@ typedef struct AbShape_s {		/* base type for all abstrct shapes */
  */
 void abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds);
 
+/** Compute the geometry abShapeSpan needs for abShape at centerPos
+ *
+ *  \param s (in) The abstract shape
+ *  \param centerPos (in) The Vec2 specifying the center position of the shape
+ *  \param geom (out) Its bounds, with derived values still to be computed
+ */
+void abShapeGeom(const AbShape *s, const Vec2 *centerPos, ShapeGeom *geom);
+
 /** Check if pixel is within the abShape centered at centerPos
  *
  *  \param shape (in) The abstract shape
@@ -102,6 +152,19 @@ void abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds);
  */
 int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
 
+/** Compute the runs of row covered by abShape centered at centerPos
+ *
+ *  Only valid for shapes whose span field is non-zero.
+ *
+ *  \param shape (in) The abstract shape
+ *  \param centerPos (in) The Vec2 specifying the center position of the shape
+ *  \param geom (in/out) The shape's geometry at centerPos (from abShapeGeom)
+ *  \param row (in) The screen row being rendered
+ *  \param spans (out) Up to SHAPE_MAX_SPANS covered runs
+ *  \return The number of spans stored
+ */
+int abShapeSpan(const AbShape *shape, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+
 /** An AbShape Right Arrow with filled tip
  *
  *  size: width of the arrow.  Tip is a triangle with width=1/2 size.
@@ -110,6 +173,7 @@ int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelL
 typedef struct AbRArrow_s {
   void (*getBounds)(const struct AbRArrow_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRArrow_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  int (*span)(const struct AbRArrow_s *shape, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
   int size;
 } AbRArrow;
 
@@ -121,6 +185,10 @@ void abRArrowGetBounds(const AbRArrow *arrow, const Vec2 *centerPos, Region *bou
  */
 int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+int abRArrowSpan(const AbRArrow *arrow, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+
 /** AbShape rectangle
  *
  *  Vector halfSize must be to first quadrant (both axes non-negative).  
@@ -129,6 +197,7 @@ int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixe
 typedef struct AbRect_s {
   void (*getBounds)(const struct AbRect_s *rect, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRect_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbRect_s *shape, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
   const Vec2 halfSize;	
 } AbRect;
 
@@ -140,6 +209,10 @@ void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds);
  */
 int abRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+int abRectSpan(const AbRect *rect, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+
 typedef AbRect AbRectOutline;	/* same as AbRect */
 
 /** As required by AbShape
@@ -150,6 +223,71 @@ void abRectOutlineGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *b
  */
 int abRectOutlineCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+int abRectOutlineSpan(const AbRect *rect, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+
+/** AbShape text: the set pixels of string drawn in font
+ *
+ *  The string is centered on centerPos, with a 1 pixel gap between 
+ *  characters (see fontStringWidth).  Pixels between strokes are not 
+ *  part of the shape, so lower layers show through.  string may be 
+ *  changed between frames (see dirtyAddText).
+ */
+typedef struct AbText_s {
+  void (*getBounds)(const struct AbText_s *text, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbText_s *text, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbText_s *text, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+  const Font *font;
+  const char *string;
+} AbText;
+
+/** As required by AbShape
+ */
+void abTextGetBounds(const AbText *text, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abTextCheck(const AbText *text, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+int abTextSpan(const AbText *text, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+
+/** AbShape sprite: a picture stored as runs of pixels of one color
+ *
+ *  Each row of the width x height picture is a list of runs of 3 bytes:
+ *  first column (from the left edge), length, and palette index.
+ *  Columns that no run covers are transparent.  rows[y] is the offset
+ *  in runs of row y's first run (rows[height] is the end of the last
+ *  row).  palette holds the runs' colors (BGR565); if it is 0 every run
+ *  is drawn in the layer's color.  The picture is centered on centerPos
+ *  (its left column is centerPos - width/2).  makeSprite writes sprites
+ *  from PBM and PPM images.
+ */
+typedef struct AbSprite_s {
+  void (*getBounds)(const struct AbSprite_s *sprite, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbSprite_s *sprite, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbSprite_s *sprite, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+  const u_char *runs;
+  const u_int *rows;
+  const u_int *palette;
+  u_char width, height;
+} AbSprite;
+
+/** As required by AbShape
+ */
+void abSpriteGetBounds(const AbSprite *sprite, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abSpriteCheck(const AbSprite *sprite, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape.  Reports the runs from spans[0].colStart on,
+ *  each with its palette color.
+ */
+int abSpriteSpan(const AbSprite *sprite, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[]);
+
 /** Linked list of Layers.  
  * 
  *  Each layer contains
@@ -165,6 +303,24 @@ typedef struct Layer_s {
   struct Layer_s *next;
 } Layer;	
 
+/** Row-band index
+ *
+ *  1: layerDrawRegion divides the rows it draws into bands of 
+ *     LAYER_BAND_ROWS rows and gives each band a bitmask of the layers
+ *     whose bounds reach it, so a row only probes layers that can cover
+ *     it.  Layers after the first LAYER_INDEX_MAX are probed on every 
+ *     row.  Costs LAYER_BANDS bytes of stack while drawing.
+ *  0: every row probes every layer.
+ *  The index is built per draw, so layers need no updating when they move.
+ */
+#ifndef LAYER_BAND_INDEX
+#define LAYER_BAND_INDEX 0
+#endif
+#define LAYER_BAND_SHIFT 3
+#define LAYER_BAND_ROWS (1 << LAYER_BAND_SHIFT)
+#define LAYER_BANDS ((screenHeight + LAYER_BAND_ROWS - 1) >> LAYER_BAND_SHIFT)
+#define LAYER_INDEX_MAX 8	/* bits in a band's mask */
+
 /** Compute layer's bounding box.
  */
 void layerGetBounds(const Layer *l, Region *bounds);
@@ -174,11 +330,143 @@ void layerGetBounds(const Layer *l, Region *bounds);
  */
 void layerInit(Layer *layers);
 
+/** Geometry cache
+ *
+ *  0: each probe computes its layer's ShapeGeom on the stack.
+ *  1: layerDrawRegion computes the ShapeGeom of the first LAYER_GEOM_MAX
+ *     layers once and reuses it for every row it renders (so spans keep
+ *     what they derive, such as a circle's last row).  Costs 
+ *     LAYER_GEOM_MAX * sizeof(ShapeGeom) (112) bytes of stack while
+ *     drawing, too much next to an msp430g2553 program's globals, so 
+ *     the default is off.  Layers keep no geometry, whichever is set.
+ */
+#ifndef LAYER_GEOM_CACHE
+#define LAYER_GEOM_CACHE 0
+#endif
+#define LAYER_GEOM_MAX 8
+
 /** Render all layers.   
  *  Pixels that are not contained by a layer are set to bgColor.
+ *  Layers must have been initialized by layerInit.
  */
 void layerDraw(Layer *layers);
 
+/** Scanline pipeline
+ *
+ *  0: runs are streamed to the lcd as soon as they are resolved.
+ *  1: pixels are composited into one of two screenWidth-pixel line 
+ *     buffers (4*screenWidth bytes of RAM) that lcd_writeBuffer sends 
+ *     while the other is being filled.  Only worthwhile when lcdLib 
+ *     queues transfers (LCD_ASYNC); too large for parts with 512 bytes of RAM.
+ */
+#ifndef LAYER_LINE_BUFFER
+#define LAYER_LINE_BUFFER 0
+#endif
+
+/** Render all layers within area (inclusive, in screen coordinates).
+ *
+ *  Each row is resolved into runs of a single color using the layers'
+ *  span methods (falling back to check) and each run is written at once.
+ *  A run's color is its layer's, or the span's for shapes (AbSprite) 
+ *  that color their runs.
+ *  Pixels that are not contained by a layer are set to bgColor.
+ */
+void layerDrawRegion(Layer *layers, const Region *area);
+
+/** Render area with the pixels that layers have at area + shift
+ *  (e.g. to draw into lcd memory that is shown elsewhere while scrolled).
+ */
+void layerDrawRegionShifted(Layer *layers, const Region *area, const Vec2 *shift);
+
+/** Maximum number of disjoint regions the dirty-region manager tracks */
+#define DIRTY_MAX_REGIONS 4
+
+/** Cost (in pixels written) of opening an lcd window for a region.
+ *  Regions are merged whenever painting their bounding box costs no 
+ *  more than painting both separately.
+ */
+#define DIRTY_SETUP_COST 24
+
+/** Record a damaged region to be repainted by the next dirtyFlush.
+ *
+ *  Damage is clipped to the screen.  Regions that overlap, or that are
+ *  cheaper to repaint together, are merged so that tracked regions
+ *  never overlap.
+ */
+void dirtyAdd(const Region *damage);
+
+/** Record a layer's last and current bounds as damaged
+ */
+void dirtyAddLayer(const Layer *l);
+
+/** Make text layer l (whose abShape is an AbText) show string, and 
+ *  record the bounds of the old and the new string as damaged.
+ *
+ *  Both are needed: a shorter string leaves the old one's trailing 
+ *  glyphs to be erased.  To change a string's characters in place, 
+ *  do the same by hand: dirtyAddLayer(l) before changing them, and 
+ *  again after (or tileAddLayer, for the tile damage map).
+ */
+void dirtyAddText(Layer *l, const char *string);
+
+/** Repaint every damaged region (each pixel at most once) from layers
+ *  and forget the damage.
+ */
+void dirtyFlush(Layer *layers);
+
+/** Tile damage map: the screen is split into TILE_SIZE x TILE_SIZE
+ *  tiles, each with one bit of RAM (40 bytes for 8x8 tiles on a 128x160
+ *  screen).  Flushing costs at most one window per run of tiles in a
+ *  tile row, however many objects moved.
+ */
+#define TILE_SHIFT 3
+#define TILE_SIZE (1 << TILE_SHIFT)
+#define TILE_COLS ((screenWidth + TILE_SIZE - 1) >> TILE_SHIFT)
+#define TILE_ROWS ((screenHeight + TILE_SIZE - 1) >> TILE_SHIFT)
+#define TILE_ROW_BYTES ((TILE_COLS + 7) >> 3)
+
+/** Mark the tiles touched by damage (e.g. a moved layer, text or a
+ *  filled rectangle) to be repainted by the next tileFlush.
+ *
+ *  Nothing marks tiles on its own: neither lcdLib's drawing functions
+ *  nor layer moves call tileAdd, so a program that flushes tiles (in
+ *  place of dirtyFlush) marks whatever it changes itself.
+ */
+void tileAdd(const Region *damage);
+
+/** Mark the tiles touched by a layer's last and current bounds
+ */
+void tileAddLayer(const Layer *l);
+
+/** Repaint every marked tile from layers and clear the map.
+ *  Horizontally adjacent tiles are repainted through one lcd window.
+ */
+void tileFlush(Layer *layers);
+
+/** Scrolling background
+ *
+ *  A band of rows (columns in landscape orientations) spanning the 
+ *  screen is scrolled by the lcd controller (see lcd_setScrollArea), 
+ *  so moving it costs a few command bytes plus drawing the rows 
+ *  (columns) it exposes.  The band's layers are positioned in world
+ *  coordinates: the band shows world positions first+scrollPosition()
+ *  onwards along the scroll axis.  Everything drawn in the band 
+ *  scrolls with it, so other layers should stay out of it.
+ */
+
+/** Draw layers into the band of count rows (columns) starting at first
+ *  and make it scroll.
+ */
+void scrollInit(Layer *layers, u_char first, u_char count);
+
+/** Scroll the band by delta rows (columns) toward first, drawing the 
+ *  world positions exposed at its end.
+ */
+void scrollBy(u_char delta);
+
+/** Rows (columns) scrolled since scrollInit */
+int scrollPosition();
+
 /** Background color.
   */
 extern u_int bgColor;		/*  background color */
@@ -3,8 +3,8 @@
 #include "lcddraw.h"
 #include "shape.h"
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, 10,10};
-AbRArrow arrow30 = {abRArrowGetBounds, abRArrowCheck, 30};
+AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, 10,10};
+AbRArrow arrow30 = {abRArrowGetBounds, abRArrowCheck, abRArrowSpan, 30};
 
 
 Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
@@ -17,7 +17,7 @@ abSlicedRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
     return abRectCheck(rect, centerPos, pixel);
 }
 
-AbRect rect10 = {abRectGetBounds, abSlicedRectCheck, 10,10};;
+AbRect rect10 = {abRectGetBounds, abSlicedRectCheck, 0, 10,10};;
 
 
 Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
@@ -56,6 +56,7 @@ main()
   drawString5x7(20,20, "hello", COLOR_GREEN, COLOR_RED);
   shapeInit();
   
+  layerInit(&layer0);
   layerDraw(&layer0);
   
 }
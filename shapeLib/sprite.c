@@ -0,0 +1,53 @@
+#include "shape.h"
+
+// bounding box of sprite's picture, centered on centerPos
+void
+abSpriteGetBounds(const AbSprite *sprite, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft.axes[0] = centerPos->axes[0] - (sprite->width >> 1);
+  bounds->topLeft.axes[1] = centerPos->axes[1] - (sprite->height >> 1);
+  bounds->botRight.axes[0] = bounds->topLeft.axes[0] + sprite->width - 1;
+  bounds->botRight.axes[1] = bounds->topLeft.axes[1] + sprite->height - 1;
+}
+
+// true if a run of sprite covers pixel
+int
+abSpriteCheck(const AbSprite *sprite, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  const u_char *run, *end;
+  int x = pixel->axes[0] - (centerPos->axes[0] - (sprite->width >> 1));
+  int y = pixel->axes[1] - (centerPos->axes[1] - (sprite->height >> 1));
+  if (x < 0 || y < 0 || y >= sprite->height)
+    return 0;
+  end = sprite->runs + sprite->rows[y + 1];
+  for (run = sprite->runs + sprite->rows[y]; run < end; run += 3)
+    if (x < run[0] + run[1])	/* runs are in column order */
+      return x >= run[0];
+  return 0;
+}
+
+// runs of row from the one containing (or following) spans[0].colStart on
+int
+abSpriteSpan(const AbSprite *sprite, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  const Region *bounds = &geom->bounds;
+  const u_char *run, *end;
+  int left = bounds->topLeft.axes[0];
+  int from = spans[0].colStart - left;
+  int y = row - bounds->topLeft.axes[1];
+  int numSpans = 0;
+  if (y < 0 || y >= sprite->height)
+    return 0;
+  end = sprite->runs + sprite->rows[y + 1];
+  for (run = sprite->runs + sprite->rows[y]; run < end; run += 3) {
+    if (run[0] + run[1] <= from)
+      continue;			/* ends before from */
+    spans[numSpans].colStart = left + run[0];
+    spans[numSpans].colEnd = left + run[0] + run[1] - 1;
+    if (sprite->palette)
+      spans[numSpans].color = sprite->palette[run[2]];
+    if (++numSpans == SHAPE_MAX_SPANS)
+      break;
+  }
+  return numSpans;
+}
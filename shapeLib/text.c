@@ -0,0 +1,65 @@
+#include "shape.h"
+#include "lcddraw.h"
+
+// bounding box of string drawn in font, centered on centerPos
+void
+abTextGetBounds(const AbText *text, const Vec2 *centerPos, Region *bounds)
+{
+  int width = fontStringWidth(text->font, text->string);
+  int height = text->font->height;
+  bounds->topLeft.axes[0] = centerPos->axes[0] - (width >> 1);
+  bounds->topLeft.axes[1] = centerPos->axes[1] - (height >> 1);
+  bounds->botRight.axes[0] = bounds->topLeft.axes[0] + width - 1;
+  bounds->botRight.axes[1] = bounds->topLeft.axes[1] + height - 1;
+}
+
+// true if pixel is a set pixel of one of text's glyphs
+int
+abTextCheck(const AbText *text, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  const Font *font = text->font;
+  const char *c = text->string;
+  Region bounds;
+  int x, y;
+  abTextGetBounds(text, centerPos, &bounds);
+  x = pixel->axes[0] - bounds.topLeft.axes[0];
+  y = pixel->axes[1] - bounds.topLeft.axes[1];
+  if (x < 0 || y < 0 || y >= font->height)
+    return 0;
+  for (; *c && x > font->width; c++) /* find x's character */
+    x -= font->width + 1;
+  return *c && x < font->width && fontBit(font, fontGlyph(font, *c), x, y);
+}
+
+// runs of set pixels in row, from the glyph containing spans[0].colStart on
+int
+abTextSpan(const AbText *text, const Vec2 *centerPos, ShapeGeom *geom, int row, Span spans[])
+{
+  const Region *bounds = &geom->bounds;
+  const Font *font = text->font;
+  const char *c = text->string;
+  int y = row - bounds->topLeft.axes[1];
+  int from = spans[0].colStart;
+  int cellCol = bounds->topLeft.axes[0];	/* left column of *c */
+  int numSpans = 0;
+  if (y < 0 || y >= font->height)
+    return 0;
+  for (; *c && cellCol + font->width <= from; c++) /* skip glyphs before from */
+    cellCol += font->width + 1;
+  for (; *c; c++, cellCol += font->width + 1) {
+    const u_char *glyph = fontGlyph(font, *c);
+    u_char x;
+    for (x = 0; x < font->width; x++) {
+      u_char start = x;
+      while (x < font->width && fontBit(font, glyph, x, y))
+	x++;
+      if (x == start || cellCol + x - 1 < from)
+	continue;		/* no run, or run ends before from */
+      spans[numSpans].colStart = cellCol + start;
+      spans[numSpans].colEnd = cellCol + x - 1;
+      if (++numSpans == SHAPE_MAX_SPANS)
+	return numSpans;
+    }
+  }
+  return numSpans;
+}
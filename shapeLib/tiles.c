@@ -0,0 +1,70 @@
+#include "shape.h"
+
+/** Damaged tiles since the last tileFlush, one bit per tile.
+ *  Bit (col & 7) of tileMap[row][col >> 3] is tile (col, row).
+ */
+static u_char tileMap[TILE_ROWS][TILE_ROW_BYTES];
+
+void
+tileAdd(const Region *damage)
+{
+  Region r = *damage;
+  int col, colMax, row, rowMax;
+
+  regionClipScreen(&r);
+  if (r.topLeft.axes[0] > r.botRight.axes[0] ||
+      r.topLeft.axes[1] > r.botRight.axes[1])
+    return;
+
+  colMax = r.botRight.axes[0] >> TILE_SHIFT;
+  rowMax = r.botRight.axes[1] >> TILE_SHIFT;
+  if (colMax >= TILE_COLS)	/* screenSize is one past the last pixel */
+    colMax = TILE_COLS - 1;
+  if (rowMax >= TILE_ROWS)
+    rowMax = TILE_ROWS - 1;
+  for (row = r.topLeft.axes[1] >> TILE_SHIFT; row <= rowMax; row++)
+    for (col = r.topLeft.axes[0] >> TILE_SHIFT; col <= colMax; col++)
+      tileMap[row][col >> 3] |= 1 << (col & 7);
+}
+
+void
+tileAddLayer(const Layer *l)
+{
+  Region bounds;
+  layerGetBounds(l, &bounds);
+  tileAdd(&bounds);
+}
+
+// true if tile (col, row) is damaged
+static int
+tileDirty(u_char row, u_char col)
+{
+  return tileMap[row][col >> 3] & (1 << (col & 7));
+}
+
+void
+tileFlush(Layer *layers)
+{
+  u_char row, col, i;
+  Region area;
+
+  for (row = 0; row < TILE_ROWS; row++) {
+    area.topLeft.axes[1] = row << TILE_SHIFT;
+    area.botRight.axes[1] = area.topLeft.axes[1] + TILE_SIZE - 1;
+    if (area.botRight.axes[1] >= screenHeight)
+      area.botRight.axes[1] = screenHeight - 1;
+    for (col = 0; col < TILE_COLS; col++) {
+      if (!tileDirty(row, col))
+	continue;
+      area.topLeft.axes[0] = col << TILE_SHIFT;
+      while (col + 1 < TILE_COLS && tileDirty(row, col + 1))
+	col++;			/* one window for adjacent tiles */
+      area.botRight.axes[0] = (col << TILE_SHIFT) + TILE_SIZE - 1;
+      if (area.botRight.axes[0] >= screenWidth)
+	area.botRight.axes[0] = screenWidth - 1;
+      layerDrawRegion(layers, &area);
+    }
+    for (i = 0; i < TILE_ROW_BYTES; i++)
+      tileMap[row][i] = 0;
+  }
+}
@@ -6,22 +6,43 @@ void configureClocks(){
   BCSCTL1 = CALBC1_16MHZ;  // Set DCO to 16 Mhz
   DCOCTL = CALDCO_16MHZ;
     
-  BCSCTL2 &= ~(SELS);     // SMCLK source = DCO
+  BCSCTL2 &= ~(SELS | DIVS_3); // SMCLK source = DCO
+#if SMCLK_DIVIDE_SHIFT == 3
   BCSCTL2 |= DIVS_3;      // SMCLK = DCO / 8
+#elif SMCLK_DIVIDE_SHIFT == 1
+  BCSCTL2 |= DIVS_1;      // SMCLK = DCO / 2
+#endif
 }
 
 
 // enable watchdog timer periodic interrupt
-// period = SMCLOCK/32k
+// period = SMCLOCK/WDT_SMCLK_DIVIDE
 void enableWDTInterrupts()  
 {
   WDTCTL = WDTPW |	   // passwd req'd.  Otherwise device resets
     WDTTMSEL |		     // watchdog interval mode 
     WDTCNTCL |		     // clear watchdog count
-    1;			     // divide SMCLK by 8192
+#if WDT_SMCLK_DIVIDE == 8192L
+    WDTIS0;		     // divide SMCLK by 8192
+#else
+    0;			     // divide SMCLK by 32768
+#endif
   IE1 |= WDTIE;		   // Enable watchdog interval timer interrupt
 }
 
+// nonzero when this WDT interrupt completes a tick
+// (every WDT_INTERRUPTS_PER_TICK'th interrupt)
+int wdtTick()
+{
+#if WDT_INTERRUPTS_PER_TICK > 1
+  static unsigned char interrupts = 0;
+  if (++interrupts < WDT_INTERRUPTS_PER_TICK)
+    return 0;
+  interrupts = 0;
+#endif
+  return 1;
+}
+
 
 void timerAUpmode()
 {
@@ -31,8 +52,15 @@ void timerAUpmode()
   
   // Timer A control:
   //  Timer clock source 2: system clock (SMCLK)
+  //  Input divider: SMCLK >> TIMER_A_DIVIDE_SHIFT (TIMER_A_HZ)
   //  Mode Control 1: continuously 0...CCR0
+#if TIMER_A_DIVIDE_SHIFT == 3
+  TACTL = TASSEL_2 + ID_3 + MC_1;
+#elif TIMER_A_DIVIDE_SHIFT == 2
+  TACTL = TASSEL_2 + ID_2 + MC_1;
+#else
   TACTL = TASSEL_2 + MC_1;   
+#endif
 }
 
 
@@ -1,8 +1,74 @@
 #ifndef timerLib_included
 #define timerLib_included
 
+/** Clock profiles
+ *
+ *  MCLK always runs from the 16 MHz DCO.  The profile selects SMCLK,
+ *  which clocks the LCD's SPI port (1:1), timer A and the watchdog
+ *  interval timer.
+ *
+ *  CLOCK_PROFILE_2MHZ:  SMCLK = DCO/8 (the original configuration)
+ *  CLOCK_PROFILE_8MHZ:  SMCLK = DCO/2 (default)
+ *  CLOCK_PROFILE_16MHZ: SMCLK = DCO (above the ST7735's rated 15 MHz
+ *                       SPI write clock; most modules cope)
+ *
+ *  timerLib and the programs using it must be built with the same 
+ *  profile (e.g. "make TIMERFLAGS=-DCLOCK_PROFILE=CLOCK_PROFILE_8MHZ").
+ */
+#define CLOCK_PROFILE_2MHZ	0
+#define CLOCK_PROFILE_8MHZ	1
+#define CLOCK_PROFILE_16MHZ	2
+
+#ifndef CLOCK_PROFILE
+#define CLOCK_PROFILE CLOCK_PROFILE_8MHZ
+#endif
+
+#if CLOCK_PROFILE == CLOCK_PROFILE_2MHZ
+# define SMCLK_DIVIDE_SHIFT 3	/**< SMCLK = DCO >> 3 */
+#elif CLOCK_PROFILE == CLOCK_PROFILE_8MHZ
+# define SMCLK_DIVIDE_SHIFT 1
+#elif CLOCK_PROFILE == CLOCK_PROFILE_16MHZ
+# define SMCLK_DIVIDE_SHIFT 0
+#else
+# error "unknown CLOCK_PROFILE"
+#endif
+
+#define DCO_HZ 16000000L
+#define SMCLK_HZ (DCO_HZ >> SMCLK_DIVIDE_SHIFT)
+
+/** Watchdog interval timer
+ *
+ *  The tick is SMCLK/8192 in the original profile (about 244 Hz).
+ *  Faster profiles divide by 32768; at 16 MHz that interrupts twice 
+ *  per tick, so handlers return unless wdtTick() says the interrupt
+ *  completes a tick, keeping the same tick rate.
+ */
+#if SMCLK_DIVIDE_SHIFT >= 2
+# define WDT_SMCLK_DIVIDE 8192L
+#else
+# define WDT_SMCLK_DIVIDE 32768L
+#endif
+#define WDT_INTERRUPTS_PER_TICK (SMCLK_HZ / WDT_SMCLK_DIVIDE / 244)
+#define WDT_TICK_HZ (SMCLK_HZ / WDT_SMCLK_DIVIDE / WDT_INTERRUPTS_PER_TICK)
+
+/** Timer A
+ *
+ *  timerAUpmode divides SMCLK by 1, 4 or 8 (ID_x) so timer A counts at
+ *  2 MHz in every profile, and tone periods fit its 16 bit registers.
+ */
+#define TIMER_A_DIVIDE_SHIFT (SMCLK_DIVIDE_SHIFT >= 3 ? 0 : 3 - SMCLK_DIVIDE_SHIFT)
+#define TIMER_A_HZ (SMCLK_HZ >> TIMER_A_DIVIDE_SHIFT)
+
+/** Timer A cycles in one period of a tone of hz Hz, e.g. for a buzzer
+ *  driven by timerAUpmode.  Tones below TIMER_A_HZ/65536 (31 Hz) do
+ *  not fit CCR0 and fail to compile.
+ */
+#define TONE_PERIOD(hz) ((unsigned int)(TIMER_A_HZ / (hz))		\
+			 + 0 * sizeof(char[TIMER_A_HZ / (hz) <= 0xffffL ? 1 : -1]))
+
 void configureClocks();
 void enableWDTInterrupts();
+int wdtTick();
 void timerAUpmode();
 
 #endif